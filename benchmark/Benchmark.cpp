@@ -0,0 +1,142 @@
+//
+//  Benchmark.cpp
+//  react-native-fast-opencv
+//
+
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+Benchmark::Benchmark(int iterations, std::string filter) {
+    this->iterations = iterations;
+    this->filter = filter;
+}
+
+void Benchmark::run(const std::string& name, const std::function<void()>& body) {
+    run(name, this->iterations, body);
+}
+
+void Benchmark::setCleanup(const std::function<void()>& cleanup) {
+    this->cleanup = cleanup;
+}
+
+void Benchmark::run(const std::string& name, int iterations, const std::function<void()>& body) {
+    if (iterations <= 0) {
+        throw std::invalid_argument("Benchmark " + name + " needs at least one iteration");
+    }
+
+    if (!filter.empty() && name.find(filter) == std::string::npos) {
+        return;
+    }
+
+    body();
+    if (cleanup) {
+        cleanup();
+    }
+
+    std::vector<double> samples(iterations);
+
+    for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        samples[i] = std::chrono::duration<double, std::micro>(end - start).count();
+
+        if (cleanup) {
+            cleanup();
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.median = samples[iterations / 2];
+    result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / iterations;
+    result.min = samples.front();
+
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << result.median << " us" << std::endl;
+
+    results.push_back(result);
+}
+
+void Benchmark::print() const {
+    std::cout << std::endl << std::left << std::setw(48) << "name"
+              << std::right << std::setw(14) << "median (us)"
+              << std::setw(14) << "mean (us)"
+              << std::setw(14) << "min (us)" << std::endl;
+
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(48) << result.name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << result.median
+                  << std::setw(14) << result.mean
+                  << std::setw(14) << result.min << std::endl;
+    }
+}
+
+bool Benchmark::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    for (const auto& result : results) {
+        file << result.name << '\t' << result.iterations << '\t'
+             << result.median << '\t' << result.mean << '\t' << result.min << '\n';
+    }
+
+    return file.good();
+}
+
+std::map<std::string, double> Benchmark::load(const std::string& path) {
+    std::map<std::string, double> medians;
+    std::ifstream file(path);
+    std::string line;
+
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        int iterations;
+        double median;
+
+        if (std::getline(fields, name, '\t') && fields >> iterations >> median) {
+            medians[name] = median;
+        }
+    }
+
+    return medians;
+}
+
+int Benchmark::compare(const std::string& baselinePath, double tolerance) const {
+    auto baseline = load(baselinePath);
+    int regressions = 0;
+
+    for (const auto& result : results) {
+        auto previous = baseline.find(result.name);
+
+        if (previous == baseline.end()) {
+            continue;
+        }
+
+        double limit = previous->second * (1.0 + tolerance);
+
+        if (result.median > limit) {
+            std::cout << "REGRESSION " << result.name << ": " << result.median
+                      << " us (baseline " << previous->second << " us)" << std::endl;
+            regressions++;
+        }
+    }
+
+    return regressions;
+}
@@ -0,0 +1,47 @@
+//
+//  Benchmark.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef Benchmark_hpp
+#define Benchmark_hpp
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+    std::string name;
+    int iterations;
+    double median;
+    double mean;
+    double min;
+};
+
+// Minimal timing harness: every case is warmed up once and then timed per
+// iteration, results are reported in microseconds. Results can be saved as a
+// tab-separated file and compared against a previous run to gate regressions.
+class Benchmark {
+private:
+    std::vector<BenchmarkResult> results;
+    std::string filter;
+    int iterations;
+    std::function<void()> cleanup;
+
+public:
+    Benchmark(int iterations, std::string filter);
+
+    void run(const std::string& name, const std::function<void()>& body);
+    void run(const std::string& name, int iterations, const std::function<void()>& body);
+    // Runs after every call of a case body, outside of the timing
+    void setCleanup(const std::function<void()>& cleanup);
+
+    void print() const;
+    bool save(const std::string& path) const;
+    int compare(const std::string& baselinePath, double tolerance) const;
+
+    static std::map<std::string, double> load(const std::string& path);
+};
+
+#endif /* Benchmark_hpp */
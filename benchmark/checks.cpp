@@ -0,0 +1,252 @@
+//
+//  checks.cpp
+//  react-native-fast-opencv
+//
+//  Correctness checks of the native cores the benchmark measures. Every check
+//  prints a line and the exit code is the number of failed checks, so the
+//  binary can run from ctest.
+//
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#include "FOCV_FeatureIndex.hpp"
+#include "FOCV_MatFile.hpp"
+#include "FOCV_TiledExecutor.hpp"
+
+static int failures = 0;
+
+static void check(const std::string& name, const std::function<bool()>& body) {
+    bool passed = false;
+
+    try {
+        passed = body();
+    } catch (const std::exception& e) {
+        std::cout << "  " << e.what() << std::endl;
+    }
+
+    std::cout << (passed ? "ok    " : "FAIL  ") << name << std::endl;
+    failures += passed ? 0 : 1;
+}
+
+static bool throws(const std::function<void()>& body) {
+    try {
+        body();
+    } catch (const std::exception&) {
+        return true;
+    }
+
+    return false;
+}
+
+static bool same(const cv::Mat& a, const cv::Mat& b) {
+    return a.type() == b.type() && a.size == b.size && (a.empty() || cv::norm(a, b, cv::NORM_INF) == 0);
+}
+
+static std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("focv_checks_" + name)).string();
+}
+
+// Overwrites `length` bytes of a file at `offset`
+static void patch(const std::string& path, size_t offset, const void* data, size_t length) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset);
+    file.write(static_cast<const char*>(data), length);
+}
+
+static size_t entryOffset(int index) {
+    return sizeof(FOCV_MatFileHeader) + index * sizeof(FOCV_MatFileEntry);
+}
+
+static void checkTiledExecutor() {
+    // Odd sizes, so the last row and column of tiles are partial
+    cv::Mat bgr(257, 333, CV_8UC3);
+    cv::randu(bgr, 0, 256);
+
+    auto op = [](const std::string& name, int ksize) {
+        FOCV_TiledOp op = FOCV_TiledOp::parse(name);
+        op.ksize = ksize;
+        return op;
+    };
+
+    FOCV_TiledOp blur = op("GaussianBlur", 5);
+    FOCV_TiledOp dilate = op("morphologyEx", 5);
+    dilate.type = cv::MORPH_DILATE;
+    FOCV_TiledOp gray = op("cvtColor", 0);
+    gray.type = cv::COLOR_BGR2GRAY;
+    FOCV_TiledOp threshold = op("adaptiveThreshold", 11);
+    threshold.type = cv::THRESH_BINARY;
+    threshold.c = 2;
+
+    std::vector<FOCV_TiledOp> chain = { blur, dilate, gray, threshold };
+
+    cv::Mat whole = bgr;
+    for (const auto& step : chain) {
+        cv::Mat next;
+        step.apply(whole, next);
+        whole = next;
+    }
+
+    FOCV_TiledOptions options;
+    options.tileSize = 64;
+
+    check("tiled/chain matches the whole image", [&]() {
+        return same(FOCV_TiledExecutor::run(bgr, chain, options), whole);
+    });
+
+    check("tiled/default tile size matches the whole image", [&]() {
+        return same(FOCV_TiledExecutor::run(bgr, chain, FOCV_TiledOptions()), whole);
+    });
+
+    check("tiled/rejects Otsu thresholds", [&]() {
+        FOCV_TiledOp otsu = op("threshold", 0);
+        otsu.type = cv::THRESH_BINARY | cv::THRESH_OTSU;
+        return throws([&]() { FOCV_TiledExecutor::run(bgr, { gray, otsu }, options); });
+    });
+
+    check("tiled/rejects Bayer demosaicing", [&]() {
+        FOCV_TiledOp bayer = op("cvtColor", 0);
+        bayer.type = cv::COLOR_BayerBG2BGR;
+        return throws([&]() { FOCV_TiledExecutor::run(bgr, { gray, bayer }, options); });
+    });
+}
+
+static void checkMatFile() {
+    std::string path = tempPath("roundtrip.mat");
+
+    cv::Mat features(48, 64, CV_32FC3);
+    cv::randu(features, -1.0f, 1.0f);
+    cv::Mat bytes(31, 17, CV_8UC1);
+    cv::randu(bytes, 0, 256);
+    int sizes[] = { 2, 3, 4, 5 };
+    cv::Mat blob(4, sizes, CV_32F);
+    cv::randu(blob, 0.0f, 1.0f);
+    // Not continuous, cloned when written
+    cv::Mat region = bytes(cv::Rect(3, 4, 9, 11));
+
+    check("matfile/round-trips a mat_vector", [&]() {
+        std::vector<cv::Mat> written = { features, bytes, blob, region, cv::Mat() };
+        std::vector<cv::Mat> read;
+
+        FOCV_MatFile::write(path, FOCV_MatFileKind::MatVector, written);
+        if (FOCV_MatFile::read(path, read) != FOCV_MatFileKind::MatVector || read.size() != written.size()) {
+            return false;
+        }
+
+        for (size_t i = 0; i < written.size(); i++) {
+            if (!same(read[i], written[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    });
+
+    check("matfile/mapped Mats outlive the read call", [&]() {
+        std::vector<cv::Mat> read;
+        FOCV_MatFile::write(path, FOCV_MatFileKind::Mat, { features });
+        FOCV_MatFile::read(path, read);
+
+        cv::Mat kept = read[0](cv::Rect(1, 1, 8, 8));
+        read.clear();
+
+        return same(kept, features(cv::Rect(1, 1, 8, 8)));
+    });
+
+    auto rewrite = [&]() {
+        FOCV_MatFile::write(path, FOCV_MatFileKind::Mat, { features });
+    };
+    auto rejected = [&]() {
+        std::vector<cv::Mat> read;
+        return throws([&]() { FOCV_MatFile::read(path, read); });
+    };
+
+    check("matfile/rejects a truncated file", [&]() {
+        rewrite();
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        return rejected();
+    });
+
+    check("matfile/rejects a wrong entry length", [&]() {
+        rewrite();
+        uint64_t length = features.total() * features.elemSize() / 2;
+        patch(path, entryOffset(0) + offsetof(FOCV_MatFileEntry, length), &length, sizeof(length));
+        return rejected();
+    });
+
+    check("matfile/rejects sizes that don't match the data", [&]() {
+        rewrite();
+        int32_t rows = features.rows * 2;
+        patch(path, entryOffset(0) + offsetof(FOCV_MatFileEntry, sizes), &rows, sizeof(rows));
+        return rejected();
+    });
+
+    check("matfile/rejects an invalid type", [&]() {
+        rewrite();
+        int32_t type = 0x7fff;
+        patch(path, entryOffset(0) + offsetof(FOCV_MatFileEntry, type), &type, sizeof(type));
+        return rejected();
+    });
+
+    check("matfile/rejects a count past the entries", [&]() {
+        rewrite();
+        uint32_t count = 1000;
+        patch(path, offsetof(FOCV_MatFileHeader, count), &count, sizeof(count));
+        return rejected();
+    });
+
+    std::filesystem::remove(path);
+}
+
+static void checkFeatureIndex() {
+    std::string path = tempPath("index.mat");
+
+    cv::Mat descriptors(10, 32, CV_8UC1);
+    cv::randu(descriptors, 0, 256);
+    cv::Mat points(10, 1, CV_32FC2);
+    cv::randu(points, 0.0f, 100.0f);
+    cv::Mat size = (cv::Mat_<int32_t>(1, 2) << 100, 100);
+
+    auto loads = [&](const std::vector<cv::Mat>& mats) {
+        FOCV_MatFile::write(path, FOCV_MatFileKind::FeatureIndex, mats);
+        FOCV_FeatureIndex index((FOCV_FeatureIndexOptions()));
+        index.load(path);
+        return index.size();
+    };
+
+    check("featureindex/loads valid references", [&]() {
+        return loads({ descriptors, points, size }) == 1;
+    });
+
+    check("featureindex/rejects float descriptors", [&]() {
+        cv::Mat floats;
+        descriptors.convertTo(floats, CV_32F);
+        return throws([&]() { loads({ floats, points, size }); });
+    });
+
+    check("featureindex/rejects fewer points than descriptors", [&]() {
+        return throws([&]() { loads({ descriptors, points.rowRange(0, 5), size }); });
+    });
+
+    check("featureindex/rejects a malformed size", [&]() {
+        return throws([&]() { loads({ descriptors, points, cv::Mat_<int32_t>(1, 1, 100) }); });
+    });
+
+    check("featureindex/rejects an incomplete reference", [&]() {
+        return throws([&]() { loads({ descriptors, points }); });
+    });
+
+    std::filesystem::remove(path);
+}
+
+int main() {
+    checkTiledExecutor();
+    checkMatFile();
+    checkFeatureIndex();
+
+    std::cout << std::endl << failures << " failed" << std::endl;
+    return failures;
+}
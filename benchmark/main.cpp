@@ -0,0 +1,438 @@
+//
+//  main.cpp
+//  react-native-fast-opencv
+//
+//  Host benchmark of the native core. The library is loaded into a Hermes
+//  runtime exactly like in the app, so the numbers include JSI dispatch.
+//
+
+#include <hermes/hermes.h>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+#include "Benchmark.hpp"
+#include "react-native-fast-opencv.h"
+#include "jsi/TypedArray.h"
+#include "ConvertImage.hpp"
+#include "FOCV_JsiObject.hpp"
+#include "FOCV_Storage.hpp"
+#include "FOCV_Trace.hpp"
+
+using namespace mrousavy;
+
+static std::vector<cv::Size> parseSizes(const std::string& value) {
+    std::vector<cv::Size> sizes;
+    std::stringstream stream(value);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        auto separator = item.find('x');
+
+        if (separator != std::string::npos) {
+            sizes.emplace_back(std::stoi(item.substr(0, separator)), std::stoi(item.substr(separator + 1)));
+        }
+    }
+
+    return sizes;
+}
+
+// Positive integer, or 0 when the value is not one
+static int parseCount(const std::string& value) {
+    try {
+        return std::max(0, std::stoi(value));
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+static std::string sizeName(const cv::Size& size) {
+    return std::to_string(size.width) + "x" + std::to_string(size.height);
+}
+
+// Inputs of the cases. They are persisted, so the results every iteration
+// stores can be cleared after it, and released together at the end.
+class Inputs {
+private:
+    jsi::Runtime& runtime;
+    std::vector<std::string> ids;
+
+public:
+    explicit Inputs(jsi::Runtime& runtime) : runtime(runtime) {}
+
+    ~Inputs() {
+        release();
+    }
+
+    // Stores a copy, taken by value so a const object is never stored as const
+    template <typename T>
+    jsi::Object wrap(const std::string& type, T object) {
+        std::string id = FOCV_Storage::save(object);
+        FOCV_Storage::persist(id);
+        ids.push_back(id);
+
+        return FOCV_JsiObject::wrap(runtime, type, id);
+    }
+
+    // Objects created through the API, like createObject results
+    void keep(const jsi::Value& object) {
+        std::string id = FOCV_JsiObject::id_from_wrap(runtime, object);
+        FOCV_Storage::persist(id);
+        ids.push_back(id);
+    }
+
+    void release() {
+        for (const auto& id : ids) {
+            FOCV_Storage::release(id);
+        }
+        ids.clear();
+    }
+};
+
+int main(int argc, char** argv) {
+    int iterations = 50;
+    std::string filter;
+    std::string output;
+    std::string baseline;
+    double tolerance = 0.1;
+    std::vector<cv::Size> sizes = { cv::Size(320, 240), cv::Size(1280, 720), cv::Size(1920, 1080) };
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--iterations" && hasValue && parseCount(argv[i + 1]) > 0) {
+            iterations = parseCount(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--sizes" && hasValue) {
+            sizes = parseSizes(argv[++i]);
+        } else if (arg == "--output" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            baseline = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            tolerance = std::stod(argv[++i]);
+        } else {
+            std::cout << "Usage: focv_benchmark [--iterations N] [--filter NAME] [--sizes WxH,...]"
+                      << " [--output FILE] [--baseline FILE] [--tolerance RATIO]" << std::endl;
+            return 1;
+        }
+    }
+
+    cv::setRNGSeed(42);
+
+    auto hermes = facebook::hermes::makeHermesRuntime();
+    jsi::Runtime& runtime = *hermes;
+
+    OpenCVPlugin::installOpenCV(runtime, nullptr);
+    auto opencv = runtime.global().getPropertyAsFunction(runtime, "__loadOpenCV").call(runtime).asObject(runtime);
+
+    auto invoke = opencv.getPropertyAsFunction(runtime, "invoke");
+    auto invokeWithRoi = opencv.getPropertyAsFunction(runtime, "invokeWithRoi");
+    auto createObject = opencv.getPropertyAsFunction(runtime, "createObject");
+    auto frameBufferToMat = opencv.getPropertyAsFunction(runtime, "frameBufferToMat");
+    auto bufferToMat = opencv.getPropertyAsFunction(runtime, "bufferToMat");
+    auto base64ToMat = opencv.getPropertyAsFunction(runtime, "base64ToMat");
+    auto bytesToMat = opencv.getPropertyAsFunction(runtime, "bytesToMat");
+    auto matToBytes = opencv.getPropertyAsFunction(runtime, "matToBytes");
+    auto matToBuffer = opencv.getPropertyAsFunction(runtime, "matToBuffer");
+    auto processTiled = opencv.getPropertyAsFunction(runtime, "processTiled");
+    auto saveMat = opencv.getPropertyAsFunction(runtime, "saveMat");
+    auto loadMat = opencv.getPropertyAsFunction(runtime, "loadMat");
+    auto toJSValue = opencv.getPropertyAsFunction(runtime, "toJSValue");
+    auto vectorToBuffer = opencv.getPropertyAsFunction(runtime, "vectorToBuffer");
+
+    Benchmark benchmark(iterations, filter);
+
+    // Shared by all frame sizes
+    Inputs shared(runtime);
+
+    benchmark.setCleanup([]() {
+        FOCV_Storage::clear();
+    });
+
+    // Storage churn runs first, because it clears every stored object.
+    benchmark.run("storage/save+clear x256", [&]() {
+        cv::Mat header(16, 16, CV_8UC1);
+
+        for (int i = 0; i < 256; i++) {
+            FOCV_Storage::save(header);
+        }
+
+        FOCV_Storage::clear();
+    });
+
+    benchmark.run("dispatch/borderInterpolate", 1000, [&]() {
+        invoke.call(runtime, "borderInterpolate", 5, 10, 4);
+    });
+
+    benchmark.run("dispatch/createObject(size)", 1000, [&]() {
+        createObject.call(runtime, "size", 3, 3);
+    });
+    FOCV_Storage::clear();
+
+    FOCV_Trace::start(1 << 16);
+    benchmark.run("dispatch/borderInterpolate+trace", 1000, [&]() {
+        invoke.call(runtime, "borderInterpolate", 5, 10, 4);
+    });
+    FOCV_Trace::stop();
+
+    std::vector<cv::Point> points(5000);
+    cv::randu(cv::Mat(points).reshape(1), 0, 1920);
+    auto pointVector = shared.wrap("point_vector", points);
+
+    benchmark.run("export/toJSValue(point_vector x5000)", [&]() {
+        toJSValue.call(runtime, pointVector);
+    });
+
+    benchmark.run("export/vectorToBuffer(point_vector x5000)", [&]() {
+        vectorToBuffer.call(runtime, pointVector);
+    });
+
+    cv::Size kernelSize(5, 5);
+    auto ksize = shared.wrap("size", kernelSize);
+
+    for (const auto& size : sizes) {
+        std::string suffix = "@" + sizeName(size);
+        Inputs inputs(runtime);
+
+        cv::Mat bgr(size, CV_8UC3);
+        cv::randu(bgr, 0, 256);
+        cv::Mat gray;
+        cv::cvtColor(bgr, gray, cv::COLOR_BGR2GRAY);
+        cv::Mat features(size, CV_32FC3);
+        cv::randu(features, 0.0f, 1.0f);
+
+        cv::Rect rect(size.width / 4, size.height / 4, size.width / 2, size.height / 2);
+        cv::Mat patch = gray(rect).clone();
+        cv::Mat blurred;
+        cv::Mat heatmap;
+        cv::Mat normalized;
+        cv::Mat canvas = gray.clone();
+
+        auto src = inputs.wrap("mat", bgr);
+        auto graySrc = inputs.wrap("mat", gray);
+        auto featureSrc = inputs.wrap("mat", features);
+        auto patchSrc = inputs.wrap("mat", patch);
+        auto dst = inputs.wrap("mat", blurred);
+        auto heatmapDst = inputs.wrap("mat", heatmap);
+        auto normalizedDst = inputs.wrap("mat", normalized);
+        auto canvasDst = inputs.wrap("mat", canvas);
+        auto roi = inputs.wrap("rect", rect);
+
+        size_t bytes = bgr.total() * bgr.elemSize();
+        TypedArray<TypedArrayKind::Uint8Array> frame(runtime, bytes);
+        frame.updateUnsafe(runtime, bgr.data, bytes);
+
+        // Buffer ingestion and export
+        benchmark.run("ingest/frameBufferToMat" + suffix, [&]() {
+            frameBufferToMat.call(runtime, size.height, size.width, frame);
+        });
+
+        benchmark.run("ingest/bufferToMat" + suffix, [&]() {
+            bufferToMat.call(runtime, size.height, size.width, frame);
+        });
+
+        benchmark.run("export/matToBuffer" + suffix, [&]() {
+            matToBuffer.call(runtime, src, "uint8");
+        });
+
+        std::string base64 = ImageConverter::mat2str(bgr);
+
+        benchmark.run("convert/mat2str" + suffix, [&]() {
+            ImageConverter::mat2str(bgr);
+        });
+
+        ImageEncodeOptions preview;
+        preview.quality = 70;
+        preview.scale = 0.5;
+
+        benchmark.run("convert/mat2str(q70,x0.5)" + suffix, [&]() {
+            ImageConverter::mat2str(bgr, preview);
+        });
+
+        benchmark.run("convert/base64ToMat" + suffix, [&]() {
+            base64ToMat.call(runtime, base64);
+        });
+
+        auto encoded = matToBytes.call(runtime, src, "jpg");
+
+        benchmark.run("convert/matToBytes" + suffix, [&]() {
+            matToBytes.call(runtime, src, "jpg");
+        });
+
+        benchmark.run("convert/bytesToMat" + suffix, [&]() {
+            bytesToMat.call(runtime, encoded);
+        });
+
+        std::string matFile = (std::filesystem::temp_directory_path() / ("focv_benchmark" + suffix + ".mat")).string();
+
+        benchmark.run("io/saveMat(float)" + suffix, [&]() {
+            saveMat.call(runtime, matFile, featureSrc);
+        });
+
+        benchmark.run("io/loadMat(float)" + suffix, [&]() {
+            loadMat.call(runtime, matFile);
+        });
+
+        benchmark.run("io/loadMat(float, copy)" + suffix, [&]() {
+            loadMat.call(runtime, matFile, true);
+        });
+
+        std::filesystem::remove(matFile);
+
+        // Dispatch overhead on a real kernel
+        benchmark.run("opencv/GaussianBlur" + suffix, [&]() {
+            cv::GaussianBlur(bgr, blurred, kernelSize, 0, 0, cv::BORDER_DEFAULT);
+        });
+
+        benchmark.run("invoke/GaussianBlur" + suffix, [&]() {
+            invoke.call(runtime, "GaussianBlur", src, dst, ksize, 0, 0, cv::BORDER_DEFAULT);
+        });
+
+        benchmark.run("invokeWithRoi/GaussianBlur(center)" + suffix, [&]() {
+            invokeWithRoi.call(runtime, roi, "GaussianBlur", src, dst, ksize, 0, 0, cv::BORDER_DEFAULT);
+        });
+
+        // Custom kernels
+        benchmark.run("kernel/grayScaleToRedHeatmap" + suffix, [&]() {
+            invoke.call(runtime, "grayScaleToRedHeatmap", graySrc, heatmapDst);
+        });
+
+        benchmark.run("kernel/minMaxNorm" + suffix, [&]() {
+            invoke.call(runtime, "minMaxNorm", featureSrc, normalizedDst);
+        });
+
+        benchmark.run("kernel/getHeatMapFromBuffer" + suffix, [&]() {
+            invoke.call(runtime, "getHeatMapFromBuffer", featureSrc, heatmapDst, false);
+        });
+
+        benchmark.run("kernel/copyToByRect" + suffix, [&]() {
+            invoke.call(runtime, "copyToByRect", patchSrc, canvasDst, roi);
+        });
+
+        benchmark.run("kernel/rotateBound" + suffix, [&]() {
+            invoke.call(runtime, "rotateBound", src, 30, 1);
+        });
+
+        cv::Mat rotation = cv::getRotationMatrix2D(cv::Point2f(size.width / 2.0f, size.height / 2.0f), 10, 1);
+        cv::Mat warped;
+        auto rotationSrc = inputs.wrap("mat", rotation);
+        auto frameSize = inputs.wrap("size", size);
+        auto warpedDst = inputs.wrap("mat", warped);
+        auto remap = createObject.call(runtime, "remap_transform");
+        inputs.keep(remap);
+        invoke.call(runtime, "setRemapWarp", remap, rotationSrc, frameSize);
+
+        benchmark.run("invoke/warpAffine" + suffix, [&]() {
+            invoke.call(runtime, "warpAffine", src, warpedDst, rotationSrc, frameSize);
+        });
+
+        benchmark.run("invoke/applyRemap(warp)" + suffix, [&]() {
+            invoke.call(runtime, "applyRemap", remap, src, warpedDst);
+        });
+
+        auto featureIndex = createObject.call(runtime, "feature_index");
+        inputs.keep(featureIndex);
+        for (int i = 0; i < 4; i++) {
+            cv::Mat reference(size.height / 2, size.width / 2, CV_8UC3);
+            cv::randu(reference, 0, 256);
+            if (i == 0) {
+                bgr(rect).copyTo(reference);
+            }
+            invoke.call(runtime, "addFeatureReference", featureIndex, FOCV_JsiObject::wrap(runtime, "mat", FOCV_Storage::save(reference)));
+        }
+
+        benchmark.run("kernel/matchFeatureIndex(4 references)" + suffix, [&]() {
+            invoke.call(runtime, "matchFeatureIndex", featureIndex, src);
+        });
+
+        cv::Mat binary;
+        std::vector<cv::Mat> contours;
+        cv::threshold(gray, binary, 200, 255, cv::THRESH_BINARY);
+        cv::findContours(binary, contours, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+        auto contourSrc = inputs.wrap("mat_vector", contours);
+
+        benchmark.run("kernel/filterContours(" + std::to_string(contours.size()) + ")" + suffix, [&]() {
+            invoke.call(runtime, "filterContours", contourSrc, 20, 0, 4, 4, 0, 0, 0.8, 5);
+        });
+
+        cv::Mat page = bgr.clone();
+        cv::Mat rectified;
+        std::vector<cv::Point> pageCorners = {
+            cv::Point(size.width / 5, size.height / 6), cv::Point(size.width * 4 / 5, size.height / 8),
+            cv::Point(size.width * 5 / 6, size.height * 5 / 6), cv::Point(size.width / 6, size.height * 4 / 5),
+        };
+        cv::fillConvexPoly(page, pageCorners, cv::Scalar(240, 240, 240));
+        auto pageSrc = inputs.wrap("mat", page);
+        auto rectifiedDst = inputs.wrap("mat", rectified);
+
+        benchmark.run("kernel/detectDocumentQuad" + suffix, [&]() {
+            invoke.call(runtime, "detectDocumentQuad", pageSrc);
+        });
+
+        auto quad = invoke.call(runtime, "detectDocumentQuad", pageSrc).asObject(runtime);
+        if (quad.getProperty(runtime, "found").getBool()) {
+            auto corners = quad.getProperty(runtime, "corners");
+            inputs.keep(corners);
+
+            benchmark.run("kernel/rectifyDocument" + suffix, [&]() {
+                invoke.call(runtime, "rectifyDocument", pageSrc, rectifiedDst, corners);
+            });
+        }
+
+        auto frameSignature = createObject.call(runtime, "frame_signature");
+        inputs.keep(frameSignature);
+
+        benchmark.run("kernel/compareFrameSignature" + suffix, [&]() {
+            invoke.call(runtime, "compareFrameSignature", frameSignature, src);
+        });
+
+        // The first call stores the reference, the measured calls then see an
+        // unchanged frame.
+        std::vector<cv::Rect> dirtyRegions;
+        auto dirtyTracker = createObject.call(runtime, "dirty_tracker");
+        inputs.keep(dirtyTracker);
+        auto dirtyRegionsDst = inputs.wrap("rect_vector", dirtyRegions);
+
+        benchmark.run("kernel/detectDirtyTiles(static)" + suffix, [&]() {
+            invoke.call(runtime, "detectDirtyTiles", dirtyTracker, src, dirtyRegionsDst);
+        });
+
+        cv::Mat chained;
+        cv::Mat dilateKernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(5, 5));
+
+        benchmark.run("opencv/GaussianBlur+dilate" + suffix, [&]() {
+            cv::GaussianBlur(bgr, chained, cv::Size(5, 5), 0);
+            cv::dilate(chained, chained, dilateKernel);
+        });
+
+        jsi::Object blurOp(runtime);
+        blurOp.setProperty(runtime, "name", "GaussianBlur");
+        blurOp.setProperty(runtime, "ksize", 5);
+        jsi::Object dilateOp(runtime);
+        dilateOp.setProperty(runtime, "name", "morphologyEx");
+        dilateOp.setProperty(runtime, "op", cv::MORPH_DILATE);
+        dilateOp.setProperty(runtime, "ksize", 5);
+        auto tiledOps = jsi::Array::createWithElements(runtime, blurOp, dilateOp);
+
+        benchmark.run("tiled/GaussianBlur+dilate" + suffix, [&]() {
+            processTiled.call(runtime, src, tiledOps);
+        });
+    }
+
+    benchmark.print();
+
+    if (!output.empty() && !benchmark.save(output)) {
+        std::cout << "Unable to write results to " << output << std::endl;
+        return 1;
+    }
+
+    if (!baseline.empty()) {
+        return benchmark.compare(baseline, tolerance) > 0 ? 2 : 0;
+    }
+
+    return 0;
+}
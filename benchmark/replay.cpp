@@ -0,0 +1,444 @@
+//
+//  replay.cpp
+//  react-native-fast-opencv
+//
+//  Re-executes a trace written by `startRecording` against the native core
+//  inside a Hermes runtime and reports per-function and end-to-end timings.
+//
+
+#include <hermes/hermes.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+#include "react-native-fast-opencv.h"
+#include "jsi/TypedArray.h"
+#include "FOCV_JsiObject.hpp"
+#include "FOCV_Recorder.hpp"
+#include "FOCV_Storage.hpp"
+
+using namespace mrousavy;
+
+struct ReplayStats {
+    int calls = 0;
+    int failures = 0;
+    double replayed = 0;
+    double recorded = 0;
+};
+
+class TraceReader {
+private:
+    const std::vector<uint8_t>& bytes;
+    size_t offset;
+
+public:
+    TraceReader(const std::vector<uint8_t>& bytes, size_t offset) : bytes(bytes), offset(offset) {}
+
+    bool done() const {
+        return offset >= bytes.size();
+    }
+
+    size_t position() const {
+        return offset;
+    }
+
+    void seek(size_t position) {
+        if (position > bytes.size()) {
+            throw std::runtime_error("Trace is truncated");
+        }
+
+        offset = position;
+    }
+
+    const uint8_t* readBytes(size_t length) {
+        if (offset + length > bytes.size()) {
+            throw std::runtime_error("Trace is truncated");
+        }
+
+        const uint8_t* data = bytes.data() + offset;
+        offset += length;
+        return data;
+    }
+
+    template <typename T>
+    T read() {
+        T value;
+        memcpy(&value, readBytes(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string readString() {
+        uint32_t length = read<uint32_t>();
+        auto data = readBytes(length);
+        return std::string(reinterpret_cast<const char*>(data), length);
+    }
+};
+
+static size_t elementSize(TypedArrayKind kind) {
+    switch (kind) {
+        case TypedArrayKind::Int16Array:
+        case TypedArrayKind::Uint16Array:
+            return 2;
+        case TypedArrayKind::Int32Array:
+        case TypedArrayKind::Uint32Array:
+        case TypedArrayKind::Float32Array:
+            return 4;
+        case TypedArrayKind::Float64Array:
+        case TypedArrayKind::BigInt64Array:
+        case TypedArrayKind::BigUint64Array:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
+// Buffers recorded only as a hash are replaced with deterministic noise of the same size.
+static std::vector<uint8_t> syntheticBytes(uint64_t hash, size_t length) {
+    std::vector<uint8_t> data(length);
+    cv::RNG rng(hash);
+
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(rng.uniform(0, 256));
+    }
+
+    return data;
+}
+
+static jsi::Value makeBuffer(jsi::Runtime& runtime, uint8_t kind, const uint8_t* data, size_t length) {
+    if (kind == FOCV_ArrayBufferKind) {
+        TypedArray<TypedArrayKind::Uint8Array> array(runtime, length);
+        memcpy(array.data(runtime), data, length);
+        return array.getBuffer(runtime);
+    }
+
+    auto typedKind = static_cast<TypedArrayKind>(kind);
+    TypedArrayBase array(runtime, length / elementSize(typedKind), typedKind);
+    memcpy(array.getBuffer(runtime).data(runtime) + array.byteOffset(runtime), data, length);
+    return jsi::Value(runtime, array);
+}
+
+static cv::Mat readMat(TraceReader& reader) {
+    int rows = reader.read<int32_t>();
+    int cols = reader.read<int32_t>();
+    int type = reader.read<int32_t>();
+    bool hasData = reader.read<uint8_t>() == 1;
+    uint32_t length = reader.read<uint32_t>();
+
+    cv::Mat mat(rows, cols, type);
+
+    if (hasData) {
+        memcpy(mat.data, reader.readBytes(length), length);
+    } else {
+        auto data = syntheticBytes(reader.read<uint64_t>(), length);
+        memcpy(mat.data, data.data(), length);
+    }
+
+    return mat;
+}
+
+template <typename T>
+static std::vector<T> readVector(TraceReader& reader) {
+    uint32_t count = reader.read<uint32_t>();
+    std::vector<T> items(count);
+    memcpy(items.data(), reader.readBytes(count * sizeof(T)), count * sizeof(T));
+    return items;
+}
+
+static std::string readSnapshot(TraceReader& reader, const std::string& type) {
+    if (type == "mat") {
+        auto mat = readMat(reader);
+        return FOCV_Storage::save(mat);
+    } else if (type == "mat_vector") {
+        uint32_t count = reader.read<uint32_t>();
+        std::vector<cv::Mat> mats;
+
+        for (uint32_t i = 0; i < count; i++) {
+            mats.push_back(readMat(reader));
+        }
+
+        return FOCV_Storage::save(mats);
+    } else if (type == "point") {
+        int x = reader.read<int32_t>();
+        int y = reader.read<int32_t>();
+        cv::Point point(x, y);
+        return FOCV_Storage::save(point);
+    } else if (type == "point_vector") {
+        auto points = readVector<cv::Point>(reader);
+        return FOCV_Storage::save(points);
+    } else if (type == "rect") {
+        cv::Rect rect = reader.read<cv::Rect>();
+        return FOCV_Storage::save(rect);
+    } else if (type == "rect_vector") {
+        auto rects = readVector<cv::Rect>(reader);
+        return FOCV_Storage::save(rects);
+    } else if (type == "size") {
+        int width = reader.read<int32_t>();
+        int height = reader.read<int32_t>();
+        cv::Size size(width, height);
+        return FOCV_Storage::save(size);
+    } else if (type == "vec3b") {
+        cv::Vec3b vec;
+        memcpy(vec.val, reader.readBytes(3), 3);
+        return FOCV_Storage::save(vec);
+    } else if (type == "scalar") {
+        cv::Scalar scalar;
+        memcpy(scalar.val, reader.readBytes(4 * sizeof(double)), 4 * sizeof(double));
+        return FOCV_Storage::save(scalar);
+    } else if (type == "rotated_rect") {
+        float x = reader.read<float>();
+        float y = reader.read<float>();
+        float width = reader.read<float>();
+        float height = reader.read<float>();
+        float angle = reader.read<float>();
+        cv::RotatedRect rect(cv::Point2f(x, y), cv::Size2f(width, height), angle);
+        return FOCV_Storage::save(rect);
+    }
+
+    throw std::runtime_error("Unsupported snapshot type " + type);
+}
+
+static jsi::Value readValue(jsi::Runtime& runtime, TraceReader& reader, std::unordered_map<uint32_t, jsi::Object>& handles) {
+    auto tag = static_cast<FOCV_RecordTag>(reader.read<uint8_t>());
+
+    switch (tag) {
+        case FOCV_RecordTag::Undefined:
+            return jsi::Value::undefined();
+        case FOCV_RecordTag::Null:
+            return jsi::Value::null();
+        case FOCV_RecordTag::Bool:
+            return jsi::Value(reader.read<uint8_t>() == 1);
+        case FOCV_RecordTag::Number:
+            return jsi::Value(reader.read<double>());
+        case FOCV_RecordTag::String:
+            return jsi::String::createFromUtf8(runtime, reader.readString());
+        case FOCV_RecordTag::Handle: {
+            reader.readString();
+            uint32_t handle = reader.read<uint32_t>();
+            auto object = handles.find(handle);
+
+            if (object == handles.end()) {
+                throw std::runtime_error("Trace references an unknown object");
+            }
+
+            return jsi::Value(runtime, object->second);
+        }
+        case FOCV_RecordTag::Buffer: {
+            uint8_t kind = reader.read<uint8_t>();
+            uint32_t length = reader.read<uint32_t>();
+            return makeBuffer(runtime, kind, reader.readBytes(length), length);
+        }
+        case FOCV_RecordTag::BufferHash: {
+            uint8_t kind = reader.read<uint8_t>();
+            uint32_t length = reader.read<uint32_t>();
+            auto data = syntheticBytes(reader.read<uint64_t>(), length);
+            return makeBuffer(runtime, kind, data.data(), length);
+        }
+        case FOCV_RecordTag::Array: {
+            uint32_t length = reader.read<uint32_t>();
+            jsi::Array array(runtime, length);
+
+            for (uint32_t i = 0; i < length; i++) {
+                array.setValueAtIndex(runtime, i, readValue(runtime, reader, handles));
+            }
+
+            return jsi::Value(runtime, array);
+        }
+        case FOCV_RecordTag::Object: {
+            uint32_t length = reader.read<uint32_t>();
+            jsi::Object object(runtime);
+
+            for (uint32_t i = 0; i < length; i++) {
+                auto name = reader.readString();
+                object.setProperty(runtime, name.c_str(), readValue(runtime, reader, handles));
+            }
+
+            return jsi::Value(runtime, object);
+        }
+    }
+
+    throw std::runtime_error("Unknown value tag in trace");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: focv_replay TRACE [--iterations N]" << std::endl;
+        return 1;
+    }
+
+    std::string path = argv[1];
+    int iterations = 1;
+
+    for (int i = 2; i < argc; i++) {
+        if (std::string(argv[i]) == "--iterations" && i + 1 < argc) {
+            try {
+                iterations = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                iterations = 0;
+            }
+
+            if (iterations < 1) {
+                std::cout << "--iterations needs a number greater than 0" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t headerSize = sizeof(FOCV_RecordMagic) + 2;
+    if (bytes.size() < headerSize || memcmp(bytes.data(), FOCV_RecordMagic, sizeof(FOCV_RecordMagic)) != 0) {
+        std::cout << path << " is not a Fast OpenCV trace" << std::endl;
+        return 1;
+    }
+
+    if (bytes[sizeof(FOCV_RecordMagic)] != FOCV_RecordVersion) {
+        std::cout << "Unsupported trace version " << int(bytes[sizeof(FOCV_RecordMagic)]) << std::endl;
+        return 1;
+    }
+
+    auto hermes = facebook::hermes::makeHermesRuntime();
+    jsi::Runtime& runtime = *hermes;
+
+    OpenCVPlugin::installOpenCV(runtime, nullptr);
+    auto opencv = runtime.global().getPropertyAsFunction(runtime, "__loadOpenCV").call(runtime).asObject(runtime);
+
+    std::unordered_map<std::string, jsi::Function> functions;
+    std::map<std::string, ReplayStats> stats;
+    std::vector<double> wallTimes;
+    double recordedTotal = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        TraceReader reader(bytes, headerSize);
+        std::unordered_map<uint32_t, jsi::Object> handles;
+        auto iterationStart = std::chrono::steady_clock::now();
+
+        try {
+            while (!reader.done()) {
+                auto kind = static_cast<FOCV_RecordKind>(reader.read<uint8_t>());
+
+                if (kind == FOCV_RecordKind::Snapshot) {
+                    uint32_t handle = reader.read<uint32_t>();
+                    std::string type = reader.readString();
+                    uint32_t length = reader.read<uint32_t>();
+                    size_t end = reader.position() + length;
+
+                    // Calls using a skipped object fail and are counted as failures
+                    try {
+                        std::string id = readSnapshot(reader, type);
+                        handles.insert_or_assign(handle, FOCV_JsiObject::wrap(runtime, type, id));
+                    } catch (const std::exception& error) {
+                        if (iteration == 0) {
+                            std::cout << "Skipping snapshot: " << error.what() << std::endl;
+                        }
+                    }
+
+                    reader.seek(end);
+                    continue;
+                }
+
+                std::string function = reader.readString();
+                uint32_t count = reader.read<uint32_t>();
+                std::vector<jsi::Value> arguments;
+                bool complete = true;
+
+                for (uint32_t i = 0; i < count; i++) {
+                    try {
+                        arguments.push_back(readValue(runtime, reader, handles));
+                    } catch (const std::exception&) {
+                        // The value could not be materialized; the rest of the record is still read.
+                        arguments.push_back(jsi::Value::undefined());
+                        complete = false;
+                    }
+                }
+
+                uint32_t resultHandle = reader.read<uint32_t>();
+                double recorded = reader.read<uint64_t>() / 1000.0;
+
+                std::string name = function;
+                if ((function == "invoke" || function == "createObject") && count > 0 && arguments[0].isString()) {
+                    name += ":" + arguments[0].getString(runtime).utf8(runtime);
+                }
+
+                auto& entry = stats[name];
+                entry.calls++;
+
+                if (iteration == 0) {
+                    entry.recorded += recorded;
+                    recordedTotal += recorded;
+                }
+
+                if (!complete) {
+                    entry.failures++;
+                    continue;
+                }
+
+                if (functions.find(function) == functions.end()) {
+                    functions.emplace(function, opencv.getPropertyAsFunction(runtime, function.c_str()));
+                }
+
+                try {
+                    auto start = std::chrono::steady_clock::now();
+                    auto result = functions.at(function).call(runtime, static_cast<const jsi::Value*>(arguments.data()), arguments.size());
+                    auto end = std::chrono::steady_clock::now();
+
+                    entry.replayed += std::chrono::duration<double, std::micro>(end - start).count();
+
+                    if (resultHandle != FOCV_NoHandle && result.isObject()) {
+                        handles.insert_or_assign(resultHandle, result.getObject(runtime));
+                    }
+                } catch (const std::exception&) {
+                    entry.failures++;
+                }
+            }
+        } catch (const std::exception& error) {
+            // Calls read before the error are still reported
+            std::cout << "Stopped reading the trace: " << error.what() << std::endl;
+        }
+
+        auto iterationEnd = std::chrono::steady_clock::now();
+        wallTimes.push_back(std::chrono::duration<double, std::micro>(iterationEnd - iterationStart).count());
+        FOCV_Storage::clear();
+    }
+
+    std::vector<std::pair<std::string, ReplayStats>> sorted(stats.begin(), stats.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.replayed > b.second.replayed;
+    });
+
+    std::cout << std::left << std::setw(40) << "function"
+              << std::right << std::setw(10) << "calls"
+              << std::setw(10) << "failed"
+              << std::setw(16) << "mean (us)"
+              << std::setw(16) << "total (us)"
+              << std::setw(18) << "device (us)" << std::endl;
+
+    double replayedTotal = 0;
+
+    for (const auto& [name, entry] : sorted) {
+        int succeeded = std::max(1, entry.calls - entry.failures);
+        replayedTotal += entry.replayed;
+
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << entry.calls
+                  << std::setw(10) << entry.failures
+                  << std::setw(16) << entry.replayed / succeeded
+                  << std::setw(16) << entry.replayed / iterations
+                  << std::setw(18) << entry.recorded << std::endl;
+    }
+
+    std::sort(wallTimes.begin(), wallTimes.end());
+
+    std::cout << std::endl
+              << "calls total:        " << replayedTotal / iterations << " us per iteration" << std::endl
+              << "end-to-end median:  " << wallTimes[wallTimes.size() / 2] << " us" << std::endl
+              << "recorded on device: " << recordedTotal << " us" << std::endl;
+
+    return 0;
+}
@@ -18,147 +18,196 @@
 using namespace std;
 using namespace cv;
 
-static const std::string base64_chars =
+static const char base64_chars[] =
 "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
 "abcdefghijklmnopqrstuvwxyz"
 "0123456789+/";
 
-static inline bool is_base64( unsigned char c )
-{
-    return (isalnum(c) || (c == '+') || (c == '/'));
-}
-
-std::string ImageConverter::base64_encode(uchar const* bytes_to_encode, unsigned int in_len)
-{
-    std::string ret;
+static const uchar base64_invalid = 0xFF;
 
-    int i = 0;
-    int j = 0;
-    unsigned char char_array_3[3];
-    unsigned char char_array_4[4];
+// Reverse lookup of base64_chars, base64_invalid for anything else
+struct Base64DecodeTable {
+    uchar values[256];
 
-    while (in_len--)
-    {
-        char_array_3[i++] = *(bytes_to_encode++);
-        if (i == 3)
-        {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; (i <4); i++)
-            {
-                ret += base64_chars[char_array_4[i]];
-            }
-            i = 0;
+    constexpr Base64DecodeTable() : values() {
+        for (int i = 0; i < 256; i++) {
+            values[i] = base64_invalid;
+        }
+        for (int i = 0; i < 64; i++) {
+            values[static_cast<uchar>(base64_chars[i])] = i;
         }
     }
+};
+
+static constexpr Base64DecodeTable base64_table;
 
-    if (i)
+std::string ImageConverter::base64_encode(uchar const* bytes_to_encode, size_t in_len)
+{
+    std::string ret(4 * ((in_len + 2) / 3), '=');
+    char* out = &ret[0];
+    size_t i = 0;
+
+    for (; i + 3 <= in_len; i += 3)
     {
-        for (j = i; j < 3; j++)
-        {
-            char_array_3[j] = '\0';
-        }
+        uint32_t triple = (bytes_to_encode[i] << 16) | (bytes_to_encode[i + 1] << 8) | bytes_to_encode[i + 2];
 
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3f;
+        *out++ = base64_chars[(triple >> 18) & 0x3f];
+        *out++ = base64_chars[(triple >> 12) & 0x3f];
+        *out++ = base64_chars[(triple >> 6) & 0x3f];
+        *out++ = base64_chars[triple & 0x3f];
+    }
 
-        for (j = 0; (j < i + 1); j++)
+    // Remaining one or two bytes, the rest of the quad stays padded
+    if (i < in_len)
+    {
+        uint32_t triple = bytes_to_encode[i] << 16;
+        if (i + 1 < in_len)
         {
-            ret += base64_chars[char_array_4[j]];
+            triple |= bytes_to_encode[i + 1] << 8;
         }
-        
-        while ((i++ < 3))
+
+        *out++ = base64_chars[(triple >> 18) & 0x3f];
+        *out++ = base64_chars[(triple >> 12) & 0x3f];
+        if (i + 1 < in_len)
         {
-            ret += '=';
+            *out++ = base64_chars[(triple >> 6) & 0x3f];
         }
     }
 
     return ret;
 }
 
-std::string ImageConverter::base64_decode(std::string const& encoded_string)
+size_t ImageConverter::base64_decoded_size(size_t in_len)
+{
+    return (in_len / 4) * 3 + 3;
+}
+
+size_t ImageConverter::base64_decode(const char* encoded, size_t in_len, uchar* output)
 {
-    int in_len = encoded_string.size();
-    int i = 0;
-    int j = 0;
-    int in_ = 0;
-    unsigned char char_array_4[4], char_array_3[3];
-    std::string ret;
-
-    while (in_len-- && (encoded_string[in_] != '=') && is_base64(encoded_string[in_]))
+    const uchar* in = reinterpret_cast<const uchar*>(encoded);
+    uchar* out = output;
+    size_t i = 0;
+
+    // Whole quads, as long as all four characters are valid
+    for (; i + 4 <= in_len; i += 4)
     {
-        char_array_4[i++] = encoded_string[in_]; in_++;
+        uchar a = base64_table.values[in[i]];
+        uchar b = base64_table.values[in[i + 1]];
+        uchar c = base64_table.values[in[i + 2]];
+        uchar d = base64_table.values[in[i + 3]];
 
-        if (i == 4)
+        if ((a | b | c | d) & 0x80)
         {
-            for (i = 0; i < 4; i++)
-            {
-                char_array_4[i] = base64_chars.find(char_array_4[i]);
-            }
-
-            char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-            char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
+            break;
+        }
 
-            for (i = 0; (i < 3); i++)
-            {
-                ret += char_array_3[i];
-            }
+        uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
 
-            i = 0;
-        }
+        *out++ = (triple >> 16) & 0xff;
+        *out++ = (triple >> 8) & 0xff;
+        *out++ = triple & 0xff;
     }
 
-    if (i)
+    // Tail: padding, a truncated quad or an invalid character
+    uchar tail[4];
+    int count = 0;
+
+    for (; i < in_len && count < 4; i++)
     {
-        for (j = i; j < 4; j++)
-        {
-            char_array_4[j] = 0;
-        }
-        
-        for (j = 0; j < 4; j++)
+        uchar value = base64_table.values[in[i]];
+        if (value == base64_invalid)
         {
-            char_array_4[j] = base64_chars.find(char_array_4[j]);
+            break;
         }
+        tail[count++] = value;
+    }
 
-        char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-        char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-        char_array_3[2] = ((char_array_4[2] & 0x3) << 6) + char_array_4[3];
-
-        for (j = 0; (j < i - 1); j++)
-        {
-            ret += char_array_3[j];
-        }
+    if (count >= 2)
+    {
+        *out++ = (tail[0] << 2) | (tail[1] >> 4);
+    }
+    if (count >= 3)
+    {
+        *out++ = ((tail[1] & 0xf) << 4) | (tail[2] >> 2);
     }
 
-    return ret;
+    return out - output;
 }
 
 string ImageConverter::mat2str(const Mat& m)
 {
-    int params[3] = {0};
-    params[0] = IMWRITE_JPEG_QUALITY;
-    params[1] = 100;
+    return mat2str(m, ImageEncodeOptions());
+}
+
+string ImageConverter::mat2str(const Mat& m, const ImageEncodeOptions& options)
+{
+    const vector<uchar>& buf = encode(m, options);
+
+    return base64_encode(buf.data(), buf.size());
+}
+
+const std::vector<uchar>& ImageConverter::encode(const Mat& m, const ImageEncodeOptions& options)
+{
+    thread_local vector<uchar> buf;
+    thread_local Mat scaled;
+    thread_local Mat converted;
 
-    vector<uchar> buf;
-    bool code = cv::imencode(".jpg", m, buf, std::vector<int>(params, params+2));
-    uchar* result = reinterpret_cast<uchar*> (&buf[0]);
+    const Mat* image = &m;
 
-    return base64_encode(result, buf.size());
+    if (options.scale > 0 && options.scale != 1.0)
+    {
+        cv::resize(*image, scaled, cv::Size(), options.scale, options.scale, options.scale < 1.0 ? INTER_AREA : INTER_LINEAR);
+        image = &scaled;
+    }
+
+    if (image->depth() != CV_8U)
+    {
+        image->convertTo(converted, CV_8U);
+        image = &converted;
+    }
+
+    std::vector<int> params;
 
+    if (options.format == "jpg" || options.format == "jpeg")
+    {
+        params = { IMWRITE_JPEG_QUALITY, options.quality };
+    }
+    else if (options.format == "webp")
+    {
+        params = { IMWRITE_WEBP_QUALITY, std::max(1, options.quality) };
+    }
+    else if (options.format == "png")
+    {
+        params = { IMWRITE_PNG_COMPRESSION, options.compression };
+    }
+
+    if (!cv::imencode("." + options.format, *image, buf, params))
+    {
+        throw std::runtime_error("Unable to encode Mat as " + options.format);
+    }
+
+    return buf;
 }
 
-Mat ImageConverter::str2mat(const string& s)
+Mat ImageConverter::str2mat(const string& s, int flags)
 {
-    // Decode data
-    string decoded_string = base64_decode(s);
-    vector<uchar> data(decoded_string.begin(), decoded_string.end());
+    // Decode data into a buffer reused between calls
+    thread_local vector<uchar> data;
+    data.resize(base64_decoded_size(s.size()));
+
+    size_t length = base64_decode(s.data(), s.size(), data.data());
+
+    return bytes2mat(data.data(), length, flags);
+}
+
+Mat ImageConverter::bytes2mat(const uchar* bytes, size_t length, int flags)
+{
+    if (length == 0)
+    {
+        return Mat();
+    }
 
-    cv::Mat img = imdecode(data, IMREAD_UNCHANGED);
-    return img;
+    // imdecode reads straight from the header, the bytes are not copied
+    Mat buffer(1, static_cast<int>(length), CV_8UC1, const_cast<uchar*>(bytes));
+    return imdecode(buffer, flags);
 }
@@ -19,14 +19,33 @@
 using namespace std;
 using namespace cv;
 
+struct ImageEncodeOptions {
+    // jpg, png or webp
+    std::string format = "jpg";
+    // JPEG and WebP quality, 0-100
+    int quality = 100;
+    // PNG compression level, 0-9
+    int compression = 1;
+    // Downscale factor applied before encoding, 1 keeps the size
+    double scale = 1.0;
+};
+
 class ImageConverter {
 public:
-    static cv::Mat str2mat(const string& imageBase64);
+    static cv::Mat str2mat(const string& imageBase64, int flags = IMREAD_UNCHANGED);
     static string mat2str(const Mat& img);
+    static string mat2str(const Mat& img, const ImageEncodeOptions& options);
+    static cv::Mat bytes2mat(const uchar* bytes, size_t length, int flags = IMREAD_UNCHANGED);
+    // Encodes into a per-thread buffer that is reused by the next call on the
+    // same thread, so the result must be consumed before encoding again.
+    static const std::vector<uchar>& encode(const Mat& img, const ImageEncodeOptions& options);
 
-private:
-    static std::string base64_encode(uchar const* bytesToEncode, unsigned int inLen);
-    static std::string base64_decode(std::string const& encodedString);
+    static std::string base64_encode(uchar const* bytesToEncode, size_t inLen);
+    // Decodes into `output`, which must hold at least base64_decoded_size(inLen)
+    // bytes. Stops at padding or at the first character outside the alphabet and
+    // returns the number of bytes written.
+    static size_t base64_decode(const char* encoded, size_t inLen, uchar* output);
+    static size_t base64_decoded_size(size_t inLen);
 };
 
 #endif
@@ -0,0 +1,78 @@
+//
+//  FOCV_BackgroundModel.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_BackgroundModel.hpp"
+
+FOCV_BackgroundModel::FOCV_BackgroundModel(const FOCV_BackgroundModelOptions& options) : options(options) {
+    if (options.method == "mog2") {
+        auto mog2 = cv::createBackgroundSubtractorMOG2();
+        if (options.threshold >= 0) {
+            mog2->setVarThreshold(options.threshold);
+        }
+        subtractor = mog2;
+    } else if (options.method == "knn") {
+        auto knn = cv::createBackgroundSubtractorKNN();
+        if (options.threshold >= 0) {
+            knn->setDist2Threshold(options.threshold);
+        }
+        subtractor = knn;
+    } else if (options.method != "average") {
+        throw std::runtime_error("Unknown background model method " + options.method);
+    }
+}
+
+void FOCV_BackgroundModel::apply(const cv::Mat& frame, cv::Mat& mask, std::vector<cv::Rect>& rects) {
+    const cv::Mat* input = &frame;
+
+    if (options.scale > 0 && options.scale < 1.0) {
+        cv::resize(frame, small, cv::Size(), options.scale, options.scale, cv::INTER_AREA);
+        input = &small;
+    }
+
+    if (subtractor) {
+        subtractor->apply(*input, mask, options.learningRate);
+        // Drop the shadows (127), keep the foreground (255)
+        cv::threshold(mask, mask, 200, 255, cv::THRESH_BINARY);
+    } else {
+        if (input->channels() == 1) {
+            gray = *input;
+        } else {
+            cv::cvtColor(*input, gray, input->channels() == 4 ? cv::COLOR_RGBA2GRAY : cv::COLOR_RGB2GRAY);
+        }
+
+        if (background.empty() || background.size() != gray.size()) {
+            gray.convertTo(background, CV_32F);
+        }
+
+        background.convertTo(backgroundU8, CV_8U);
+        cv::absdiff(gray, backgroundU8, mask);
+        cv::threshold(mask, mask, options.threshold >= 0 ? options.threshold : 25, 255, cv::THRESH_BINARY);
+        cv::accumulateWeighted(gray, background, options.learningRate >= 0 ? options.learningRate : 0.05);
+    }
+
+    rects.clear();
+
+    if (cv::countNonZero(mask) == 0) {
+        return;
+    }
+
+    mask.copyTo(contoursInput);
+    cv::findContours(contoursInput, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    double inverse = 1.0 / (input == &small ? options.scale : 1.0);
+    cv::Rect bounds({}, frame.size());
+
+    for (const auto& contour : contours) {
+        cv::Rect rect = cv::boundingRect(contour);
+
+        if (input == &small) {
+            rect = cv::Rect(cvFloor(rect.x * inverse), cvFloor(rect.y * inverse), cvCeil(rect.width * inverse), cvCeil(rect.height * inverse)) & bounds;
+        }
+
+        if (rect.area() >= options.minArea) {
+            rects.push_back(rect);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+//
+//  FOCV_BackgroundModel.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_BackgroundModel_hpp
+#define FOCV_BackgroundModel_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+struct FOCV_BackgroundModelOptions {
+    // mog2, knn or average
+    std::string method = "mog2";
+    // Frames are downscaled by this factor before the model is updated
+    double scale = 1.0;
+    // Negative selects the automatic rate of MOG2 and KNN; the running
+    // average then uses 0.05.
+    double learningRate = -1;
+    // Method specific: varThreshold for MOG2, dist2Threshold for KNN, the
+    // absolute gray level difference for the running average. Negative keeps
+    // the default.
+    double threshold = -1;
+    // Changed regions smaller than this (in frame pixels) are ignored
+    double minArea = 0;
+};
+
+// Background model updated incrementally with every frame. It produces the
+// foreground mask and the bounding rects of the changed regions.
+class FOCV_BackgroundModel {
+private:
+    FOCV_BackgroundModelOptions options;
+    cv::Ptr<cv::BackgroundSubtractor> subtractor;
+    cv::Mat small;
+    cv::Mat gray;
+    cv::Mat background;
+    cv::Mat backgroundU8;
+    cv::Mat contoursInput;
+    std::vector<std::vector<cv::Point>> contours;
+
+public:
+    FOCV_BackgroundModel(const FOCV_BackgroundModelOptions& options);
+
+    // The mask has the size of the processed (downscaled) frame, the rects are
+    // in the coordinates of the original frame.
+    void apply(const cv::Mat& frame, cv::Mat& mask, std::vector<cv::Rect>& rects);
+};
+
+#endif /* FOCV_BackgroundModel_hpp */
@@ -0,0 +1,116 @@
+//
+//  FOCV_BatchDecode.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_BatchDecode.hpp"
+#include "ConvertImage.hpp"
+#include "FOCV_FileIO.hpp"
+#include "FOCV_Trace.hpp"
+
+cv::Mat FOCV_BatchDecode::decodeOne(const FOCV_DecodeSource& source, const FOCV_DecodeOptions& options) {
+    cv::Mat mat;
+
+    switch (source.kind) {
+        case FOCV_DecodeSourceKind::Base64:
+            mat = ImageConverter::str2mat(source.text, options.flags);
+            break;
+        case FOCV_DecodeSourceKind::Bytes:
+            mat = ImageConverter::bytes2mat(source.bytes.data(), source.bytes.size(), options.flags);
+            break;
+        case FOCV_DecodeSourceKind::Path:
+            mat = FOCV_FileIO::read(source.text, options.flags);
+            break;
+    }
+
+    if (mat.empty()) {
+        throw std::runtime_error("Unable to decode image");
+    }
+
+    if (options.box.empty()) {
+        return mat;
+    }
+
+    double scale = std::min(static_cast<double>(options.box.width) / mat.cols, static_cast<double>(options.box.height) / mat.rows);
+
+    if (scale < 1.0) {
+        cv::Size size(std::max(1, cvRound(mat.cols * scale)), std::max(1, cvRound(mat.rows * scale)));
+        cv::Mat resized;
+
+        cv::resize(mat, resized, size, 0, 0, cv::INTER_AREA);
+        return resized;
+    }
+
+    return mat;
+}
+
+std::vector<cv::Mat> FOCV_BatchDecode::decode(const std::vector<FOCV_DecodeSource>& sources, const FOCV_DecodeOptions& options, std::vector<std::string>& errors) {
+    std::vector<cv::Mat> mats(sources.size());
+    errors.assign(sources.size(), std::string());
+
+    // One image per task; each slot is written by exactly one task.
+    cv::parallel_for_(cv::Range(0, static_cast<int>(sources.size())), [&](const cv::Range& range) {
+        for (int i = range.start; i < range.end; i++) {
+            FOCV_TraceScope trace("conversion", "batchDecode:image");
+
+            try {
+                mats[i] = decodeOne(sources[i], options);
+            } catch (const std::exception& e) {
+                mats[i] = cv::Mat();
+                errors[i] = e.what();
+            } catch (...) {
+                mats[i] = cv::Mat();
+                errors[i] = "Unable to decode image";
+            }
+        }
+    }, static_cast<double>(sources.size()));
+
+    return mats;
+}
+
+FOCV_DecodeWorker::~FOCV_DecodeWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        tasks.clear();
+    }
+
+    condition.notify_one();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void FOCV_DecodeWorker::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+
+        if (!thread.joinable()) {
+            thread = std::thread(&FOCV_DecodeWorker::run, this);
+        }
+    }
+
+    condition.notify_one();
+}
+
+void FOCV_DecodeWorker::run() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            if (stopping) {
+                return;
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
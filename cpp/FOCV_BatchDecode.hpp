@@ -0,0 +1,83 @@
+//
+//  FOCV_BatchDecode.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_BatchDecode_hpp
+#define FOCV_BatchDecode_hpp
+
+#include <stdio.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+enum class FOCV_DecodeSourceKind {
+    Base64,
+    Bytes,
+    Path,
+};
+
+// Owns its input, so it can be decoded off the JS thread.
+struct FOCV_DecodeSource {
+    FOCV_DecodeSourceKind kind;
+    std::string text;
+    std::vector<uchar> bytes;
+};
+
+struct FOCV_DecodeOptions {
+    // Same default as base64ToMat and bytesToMat
+    int flags = cv::IMREAD_UNCHANGED;
+    // Images larger than the box are downscaled to fit, keeping the aspect
+    // ratio. An empty box keeps the decoded size.
+    cv::Size box;
+};
+
+class FOCV_BatchDecode {
+public:
+    // Decodes all sources in parallel. Sources that fail to decode produce an
+    // empty Mat, so indices always match the input, and the reason is stored at
+    // the same index of errors. Errors are empty for decoded images.
+    static std::vector<cv::Mat> decode(const std::vector<FOCV_DecodeSource>& sources, const FOCV_DecodeOptions& options, std::vector<std::string>& errors);
+
+private:
+    static cv::Mat decodeOne(const FOCV_DecodeSource& source, const FOCV_DecodeOptions& options);
+};
+
+// Runs decode batches one after another on a single thread that is started on
+// first use and joined on destruction. Batches that have not started by then
+// are dropped.
+class FOCV_DecodeWorker {
+public:
+    ~FOCV_DecodeWorker();
+
+    void submit(std::function<void()> task);
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+    std::thread thread;
+
+    void run();
+};
+
+#endif /* FOCV_BatchDecode_hpp */
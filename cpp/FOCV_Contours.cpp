@@ -0,0 +1,114 @@
+//
+//  FOCV_Contours.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_Contours.hpp"
+#include <algorithm>
+
+static bool outside(double value, double min, double max) {
+    return value < min || (max > 0 && value > max);
+}
+
+static float sortValue(const FOCV_ContourMetrics& metrics, FOCV_ContourSortKey key) {
+    switch (key) {
+        case FOCV_ContourSortKey::Perimeter: return metrics.perimeter;
+        case FOCV_ContourSortKey::Aspect: return metrics.aspect;
+        case FOCV_ContourSortKey::Solidity: return metrics.solidity;
+        case FOCV_ContourSortKey::Vertices: return metrics.vertices;
+        default: return metrics.area;
+    }
+}
+
+std::vector<FOCV_ContourMetrics> FOCV_Contours::filter(const std::vector<cv::Mat>& contours, const FOCV_ContourFilter& options, std::vector<cv::Mat>* approx) {
+    std::vector<FOCV_ContourMetrics> result;
+    std::vector<cv::Mat> polygons;
+    cv::Mat polygon;
+    cv::Mat hull;
+
+    // Cheapest tests first: most contours of a real frame are rejected by
+    // area before anything is allocated for them.
+    for (size_t i = 0; i < contours.size(); i++) {
+        const cv::Mat& contour = contours[i];
+
+        if (contour.total() < 3) {
+            continue;
+        }
+
+        double area = cv::contourArea(contour);
+        if (outside(area, options.minArea, options.maxArea)) {
+            continue;
+        }
+
+        double perimeter = cv::arcLength(contour, true);
+        cv::approxPolyDP(contour, polygon, options.epsilon * perimeter, true);
+
+        int vertices = static_cast<int>(polygon.total());
+        if (outside(vertices, options.minVertices, options.maxVertices)) {
+            continue;
+        }
+
+        cv::RotatedRect box = cv::minAreaRect(contour);
+        float longSide = std::max(box.size.width, box.size.height);
+        double aspect = longSide > 0 ? std::min(box.size.width, box.size.height) / longSide : 0;
+        if (outside(aspect, options.minAspect, options.maxAspect)) {
+            continue;
+        }
+
+        cv::convexHull(contour, hull);
+        double hullArea = cv::contourArea(hull);
+        double solidity = hullArea > 0 ? area / hullArea : 0;
+        if (solidity < options.minSolidity) {
+            continue;
+        }
+
+        cv::Rect bounds = cv::boundingRect(contour);
+
+        result.push_back({
+            static_cast<float>(i),
+            static_cast<float>(area),
+            static_cast<float>(perimeter),
+            static_cast<float>(aspect),
+            static_cast<float>(solidity),
+            static_cast<float>(vertices),
+            static_cast<float>(bounds.x),
+            static_cast<float>(bounds.y),
+            static_cast<float>(bounds.width),
+            static_cast<float>(bounds.height),
+        });
+
+        if (approx != nullptr) {
+            polygons.push_back(polygon);
+            polygon = cv::Mat();
+        }
+    }
+
+    std::vector<size_t> order(result.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+
+    size_t count = options.topK > 0 ? std::min<size_t>(options.topK, order.size()) : order.size();
+    auto byKey = [&](size_t a, size_t b) {
+        return sortValue(result[a], options.sortBy) > sortValue(result[b], options.sortBy);
+    };
+    std::partial_sort(order.begin(), order.begin() + count, order.end(), byKey);
+
+    std::vector<FOCV_ContourMetrics> ranked;
+    ranked.reserve(count);
+
+    if (approx != nullptr) {
+        approx->clear();
+        approx->reserve(count);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        ranked.push_back(result[order[i]]);
+
+        if (approx != nullptr) {
+            approx->push_back(polygons[order[i]]);
+        }
+    }
+
+    return ranked;
+}
@@ -0,0 +1,71 @@
+//
+//  FOCV_Contours.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_Contours_hpp
+#define FOCV_Contours_hpp
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+enum class FOCV_ContourSortKey {
+    Area = 0,
+    Perimeter,
+    Aspect,
+    Solidity,
+    Vertices,
+};
+
+// Ranges are inclusive; a maximum of 0 leaves the range open. Aspect is the
+// short over the long side of the minimum area rectangle, so it lies in
+// [0, 1] regardless of rotation. Epsilon is relative to the perimeter.
+struct FOCV_ContourFilter {
+    double minArea = 0;
+    double maxArea = 0;
+    int minVertices = 0;
+    int maxVertices = 0;
+    double minAspect = 0;
+    double maxAspect = 0;
+    double minSolidity = 0;
+    int topK = 0;
+    FOCV_ContourSortKey sortBy = FOCV_ContourSortKey::Area;
+    double epsilon = 0.02;
+};
+
+struct FOCV_ContourMetrics {
+    float index;
+    float area;
+    float perimeter;
+    float aspect;
+    float solidity;
+    float vertices;
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+class FOCV_Contours {
+public:
+    // Returns the metrics of the contours passing the filter, best first.
+    // When `approx` is given, it receives the approximated polygon of every
+    // returned contour in the same order.
+    static std::vector<FOCV_ContourMetrics> filter(const std::vector<cv::Mat>& contours, const FOCV_ContourFilter& options, std::vector<cv::Mat>* approx = nullptr);
+};
+
+#endif /* FOCV_Contours_hpp */
@@ -0,0 +1,107 @@
+//
+//  FOCV_DirtyTracker.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_DirtyTracker.hpp"
+
+// Unions overlapping rects until none overlap, so in-place operations run on
+// every pixel at most once.
+static void mergeOverlapping(std::vector<cv::Rect>& rects) {
+    bool merged = true;
+
+    while (merged) {
+        merged = false;
+
+        for (size_t i = 0; i < rects.size() && !merged; i++) {
+            for (size_t j = i + 1; j < rects.size(); j++) {
+                if ((rects[i] & rects[j]).area() > 0) {
+                    rects[i] |= rects[j];
+                    rects.erase(rects.begin() + j);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+FOCV_DirtyTracker::FOCV_DirtyTracker(const FOCV_DirtyTileOptions& options) : options(options) {
+    if (options.tileWidth <= 0 || options.tileHeight <= 0) {
+        throw std::runtime_error("Tile size must be positive");
+    }
+}
+
+int FOCV_DirtyTracker::detect(const cv::Mat& frame, std::vector<cv::Rect>& regions) {
+    regions.clear();
+
+    if (frame.empty()) {
+        return 0;
+    }
+
+    int gridCols = (frame.cols + options.tileWidth - 1) / options.tileWidth;
+    int gridRows = (frame.rows + options.tileHeight - 1) / options.tileHeight;
+
+    if (reference.empty() || reference.size() != frame.size() || reference.type() != frame.type()) {
+        frame.copyTo(reference);
+
+        regions.push_back(cv::Rect({}, frame.size()));
+        return gridCols * gridRows;
+    }
+
+    dirty.create(gridRows, gridCols, CV_8U);
+    cv::Rect bounds({}, frame.size());
+
+    // cv::norm with NORM_L1 is the vectorized sum of absolute differences
+    cv::parallel_for_(cv::Range(0, gridRows), [&](const cv::Range& range) {
+        for (int row = range.start; row < range.end; row++) {
+            uchar* flags = dirty.ptr<uchar>(row);
+
+            for (int col = 0; col < gridCols; col++) {
+                cv::Rect tile = cv::Rect(col * options.tileWidth, row * options.tileHeight, options.tileWidth, options.tileHeight) & bounds;
+                double sad = cv::norm(frame(tile), reference(tile), cv::NORM_L1);
+
+                flags[col] = sad > options.threshold * tile.area() * frame.channels() ? 255 : 0;
+            }
+        }
+    });
+
+    int count = cv::countNonZero(dirty);
+
+    if (count == 0) {
+        return 0;
+    }
+
+    cv::Mat labels, stats, centroids;
+    int groups = cv::connectedComponentsWithStats(dirty, labels, stats, centroids, 8, CV_32S);
+
+    // Label 0 is the clean background
+    for (int label = 1; label < groups; label++) {
+        const int* stat = stats.ptr<int>(label);
+        cv::Rect cells(stat[cv::CC_STAT_LEFT], stat[cv::CC_STAT_TOP], stat[cv::CC_STAT_WIDTH], stat[cv::CC_STAT_HEIGHT]);
+
+        regions.push_back(cv::Rect(cells.x * options.tileWidth, cells.y * options.tileHeight, cells.width * options.tileWidth, cells.height * options.tileHeight) & bounds);
+    }
+
+    // Bounding rects of separate groups can still overlap
+    mergeOverlapping(regions);
+
+    // Only the dirty tiles differ noticeably, the clean ones keep their
+    // reference so slow drift still adds up to a change.
+    for (int row = 0; row < gridRows; row++) {
+        const uchar* flags = dirty.ptr<uchar>(row);
+
+        for (int col = 0; col < gridCols; col++) {
+            if (flags[col]) {
+                cv::Rect tile = cv::Rect(col * options.tileWidth, row * options.tileHeight, options.tileWidth, options.tileHeight) & bounds;
+                frame(tile).copyTo(reference(tile));
+            }
+        }
+    }
+
+    return count;
+}
+
+void FOCV_DirtyTracker::reset() {
+    reference.release();
+}
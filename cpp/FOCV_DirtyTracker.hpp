@@ -0,0 +1,53 @@
+//
+//  FOCV_DirtyTracker.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_DirtyTracker_hpp
+#define FOCV_DirtyTracker_hpp
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+// A tile is dirty when the mean absolute difference of its pixels (per
+// channel) exceeds `threshold`. Tiles at the right and bottom edges may be
+// smaller than the grid.
+struct FOCV_DirtyTileOptions {
+    int tileWidth = 32;
+    int tileHeight = 32;
+    double threshold = 4;
+};
+
+// Keeps the reference frame between calls and reports where the next frame
+// differs from it.
+class FOCV_DirtyTracker {
+private:
+    FOCV_DirtyTileOptions options;
+    cv::Mat reference;
+    cv::Mat dirty;
+
+public:
+    FOCV_DirtyTracker(const FOCV_DirtyTileOptions& options);
+
+    // Fills `regions` with non-overlapping rects covering the dirty tiles,
+    // copies the dirty tiles into the reference and returns their number. The
+    // first frame, or one of another size or type, is dirty as a whole.
+    int detect(const cv::Mat& frame, std::vector<cv::Rect>& regions);
+    void reset();
+};
+
+#endif /* FOCV_DirtyTracker_hpp */
@@ -0,0 +1,53 @@
+//
+//  FOCV_DnnNet.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_DnnNet.hpp"
+#include "FOCV_FileIO.hpp"
+
+FOCV_DnnNet::FOCV_DnnNet(const std::string& model, const std::string& config, int threads) : threads(threads) {
+    net = cv::dnn::readNet(FOCV_FileIO::normalizePath(model), config.empty() ? config : FOCV_FileIO::normalizePath(config));
+
+    if (net.empty()) {
+        throw std::runtime_error("Unable to load the network from " + model);
+    }
+
+    net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    outputNames = net.getUnconnectedOutLayersNames();
+}
+
+const std::vector<cv::Mat>& FOCV_DnnNet::forward(const cv::Mat& input, const FOCV_DnnInputOptions& options) {
+    if (input.dims > 2) {
+        net.setInput(input);
+    } else {
+        cv::Size size = options.size.empty() ? input.size() : options.size;
+
+        // Same shape as the last frame: blobFromImage writes into the existing blob
+        cv::dnn::blobFromImage(input, blob, options.scale, size, options.mean, options.swapRB, options.crop, CV_32F);
+        net.setInput(blob);
+    }
+
+    if (threads <= 0) {
+        net.forward(outputs, outputNames);
+        return outputs;
+    }
+
+    int previous = cv::getNumThreads();
+    cv::setNumThreads(threads);
+
+    try {
+        net.forward(outputs, outputNames);
+    } catch (...) {
+        cv::setNumThreads(previous);
+        throw;
+    }
+
+    cv::setNumThreads(previous);
+    return outputs;
+}
+
+const std::vector<cv::String>& FOCV_DnnNet::names() const {
+    return outputNames;
+}
@@ -0,0 +1,62 @@
+//
+//  FOCV_DnnNet.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_DnnNet_hpp
+#define FOCV_DnnNet_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+// Preprocessing of an image input, like cv::dnn::blobFromImage. An empty
+// size keeps the size of the image.
+struct FOCV_DnnInputOptions {
+    cv::Size size;
+    double scale = 1.0;
+    cv::Scalar mean;
+    bool swapRB = false;
+    bool crop = false;
+};
+
+// A cv::dnn::Net on the CPU backend. The input blob is kept between calls, so
+// frames of the same size are converted into the same memory.
+class FOCV_DnnNet {
+private:
+    cv::dnn::Net net;
+    cv::Mat blob;
+    std::vector<cv::String> outputNames;
+    std::vector<cv::Mat> outputs;
+    int threads;
+
+public:
+    // The model format is deduced from the file extension, like cv::dnn::readNet.
+    // With threads above 0, OpenCV uses that many threads during forward and
+    // goes back to the previous count afterwards.
+    FOCV_DnnNet(const std::string& model, const std::string& config, int threads = 0);
+
+    // Image inputs (2 dimensions) are converted with the options, blobs
+    // (4 dimensions) are used as they are. The outputs share memory with the
+    // net and are overwritten by the next call.
+    const std::vector<cv::Mat>& forward(const cv::Mat& input, const FOCV_DnnInputOptions& options);
+
+    const std::vector<cv::String>& names() const;
+};
+
+#endif /* FOCV_DnnNet_hpp */
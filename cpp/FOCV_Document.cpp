@@ -0,0 +1,132 @@
+//
+//  FOCV_Document.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_Document.hpp"
+#include "FOCV_Contours.hpp"
+#include <algorithm>
+
+// Median of an 8-bit image, used to pick the Canny thresholds.
+static int median(const cv::Mat& gray) {
+    int histogram[256] = { 0 };
+
+    for (int y = 0; y < gray.rows; y++) {
+        const uchar* row = gray.ptr<uchar>(y);
+        for (int x = 0; x < gray.cols; x++) {
+            histogram[row[x]]++;
+        }
+    }
+
+    int half = static_cast<int>(gray.total() / 2);
+    int sum = 0;
+    for (int i = 0; i < 256; i++) {
+        sum += histogram[i];
+        if (sum > half) {
+            return i;
+        }
+    }
+
+    return 255;
+}
+
+void FOCV_Document::orderCorners(FOCV_Quad& corners) {
+    FOCV_Quad ordered = corners;
+
+    auto bySum = [](const cv::Point2f& a, const cv::Point2f& b) { return a.x + a.y < b.x + b.y; };
+    auto byDiff = [](const cv::Point2f& a, const cv::Point2f& b) { return a.y - a.x < b.y - b.x; };
+
+    ordered[0] = *std::min_element(corners.begin(), corners.end(), bySum);
+    ordered[1] = *std::min_element(corners.begin(), corners.end(), byDiff);
+    ordered[2] = *std::max_element(corners.begin(), corners.end(), bySum);
+    ordered[3] = *std::max_element(corners.begin(), corners.end(), byDiff);
+
+    corners = ordered;
+}
+
+bool FOCV_Document::detectQuad(const cv::Mat& image, int workingSize, double minAreaRatio, FOCV_Quad& corners) {
+    thread_local cv::Mat small;
+    thread_local cv::Mat gray;
+    thread_local cv::Mat blurred;
+    thread_local cv::Mat edges;
+
+    // Downscale before anything else, so no full resolution intermediate is
+    // allocated on the way to the edges.
+    double scale = std::min(1.0, static_cast<double>(workingSize) / std::max(image.cols, image.rows));
+    const cv::Mat* input = &image;
+
+    if (scale < 1.0) {
+        cv::resize(image, small, cv::Size(), scale, scale, cv::INTER_AREA);
+        input = &small;
+    }
+
+    // Mats from imread, base64ToMat and bytesToMat are BGR(A)
+    if (input->channels() != 1) {
+        cv::cvtColor(*input, gray, input->channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+        input = &gray;
+    }
+
+    cv::GaussianBlur(*input, blurred, cv::Size(5, 5), 0);
+
+    int level = median(blurred);
+    cv::Canny(blurred, edges, std::max(0.0, 0.66 * level), std::min(255.0, 1.33 * level));
+    cv::dilate(edges, edges, cv::Mat());
+
+    std::vector<cv::Mat> contours;
+    cv::findContours(edges, contours, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+
+    FOCV_ContourFilter filter;
+    filter.minArea = minAreaRatio * edges.total();
+    filter.minVertices = 4;
+    filter.maxVertices = 4;
+    filter.minSolidity = 0.9;
+    filter.topK = 1;
+
+    std::vector<cv::Mat> polygons;
+    auto found = FOCV_Contours::filter(contours, filter, &polygons);
+
+    if (found.empty()) {
+        return false;
+    }
+
+    double fx = static_cast<double>(image.cols) / edges.cols;
+    double fy = static_cast<double>(image.rows) / edges.rows;
+
+    for (int i = 0; i < 4; i++) {
+        cv::Point point = polygons[0].at<cv::Point>(i);
+        corners[i] = cv::Point2f((point.x + 0.5) * fx - 0.5, (point.y + 0.5) * fy - 0.5);
+    }
+
+    orderCorners(corners);
+    return true;
+}
+
+cv::Size FOCV_Document::rectifiedSize(const FOCV_Quad& corners) {
+    double top = cv::norm(corners[1] - corners[0]);
+    double bottom = cv::norm(corners[2] - corners[3]);
+    double left = cv::norm(corners[3] - corners[0]);
+    double right = cv::norm(corners[2] - corners[1]);
+
+    return cv::Size(cvRound(std::max(top, bottom)), cvRound(std::max(left, right)));
+}
+
+void FOCV_Document::rectify(const cv::Mat& image, const FOCV_Quad& corners, cv::Size size, cv::Mat& dst) {
+    thread_local FOCV_Quad cachedCorners;
+    thread_local cv::Size cachedSize;
+    thread_local cv::Mat transform;
+
+    if (transform.empty() || size != cachedSize || cachedCorners != corners) {
+        FOCV_Quad target = {
+            cv::Point2f(0, 0),
+            cv::Point2f(size.width - 1, 0),
+            cv::Point2f(size.width - 1, size.height - 1),
+            cv::Point2f(0, size.height - 1),
+        };
+
+        transform = cv::getPerspectiveTransform(corners.data(), target.data());
+        cachedCorners = corners;
+        cachedSize = size;
+    }
+
+    cv::warpPerspective(image, dst, transform, size, cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+}
@@ -0,0 +1,46 @@
+//
+//  FOCV_Document.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_Document_hpp
+#define FOCV_Document_hpp
+
+#include <stdio.h>
+#include <array>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+typedef std::array<cv::Point2f, 4> FOCV_Quad;
+
+class FOCV_Document {
+public:
+    // Finds the largest convex quadrilateral covering at least `minAreaRatio`
+    // of the image. Edges are detected on a copy whose long side is
+    // `workingSize`; the corners are returned in full resolution, ordered
+    // top-left, top-right, bottom-right, bottom-left.
+    static bool detectQuad(const cv::Mat& image, int workingSize, double minAreaRatio, FOCV_Quad& corners);
+
+    // Output size that keeps the longer of each pair of opposite edges.
+    static cv::Size rectifiedSize(const FOCV_Quad& corners);
+
+    // Warps the quad to a `size` image. The transform of the last call is
+    // reused while the corners and the size stay the same.
+    static void rectify(const cv::Mat& image, const FOCV_Quad& corners, cv::Size size, cv::Mat& dst);
+
+    static void orderCorners(FOCV_Quad& corners);
+};
+
+#endif /* FOCV_Document_hpp */
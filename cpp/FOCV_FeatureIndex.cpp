@@ -0,0 +1,209 @@
+//
+//  FOCV_FeatureIndex.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_FeatureIndex.hpp"
+#include "FOCV_FileIO.hpp"
+#include "FOCV_MatFile.hpp"
+#include <algorithm>
+
+// Candidates verified with a homography per frame
+static const int FOCV_FeatureCandidates = 3;
+
+FOCV_FeatureIndex::FOCV_FeatureIndex(const FOCV_FeatureIndexOptions& options)
+    : options(options),
+      orb(cv::ORB::create(options.features)),
+      matcher(cv::makePtr<cv::FlannBasedMatcher>(cv::makePtr<cv::flann::LshIndexParams>(6, 12, 1), cv::makePtr<cv::flann::SearchParams>(32))) {}
+
+void FOCV_FeatureIndex::detect(const cv::Mat& image, std::vector<cv::KeyPoint>& keypoints, cv::Mat& descriptors) {
+    if (image.channels() == 1) {
+        gray = image;
+    } else {
+        cv::cvtColor(image, gray, image.channels() == 4 ? cv::COLOR_RGBA2GRAY : cv::COLOR_RGB2GRAY);
+    }
+
+    orb->detectAndCompute(gray, cv::noArray(), keypoints, descriptors);
+}
+
+void FOCV_FeatureIndex::train() {
+    matcher->clear();
+
+    std::vector<cv::Mat> descriptors;
+    descriptors.reserve(references.size());
+    for (const auto& reference : references) {
+        descriptors.push_back(reference.descriptors);
+    }
+
+    matcher->add(descriptors);
+    matcher->train();
+    trained = true;
+}
+
+int FOCV_FeatureIndex::add(const cv::Mat& image, int& keypoints) {
+    std::vector<cv::KeyPoint> detected;
+    Reference reference;
+
+    detect(image, detected, reference.descriptors);
+
+    if (reference.descriptors.empty()) {
+        throw std::runtime_error("Reference image has no features");
+    }
+
+    cv::KeyPoint::convert(detected, reference.points);
+    reference.size = image.size();
+    references.push_back(std::move(reference));
+
+    // The LSH index is rebuilt once, on the next match
+    trained = false;
+    keypoints = static_cast<int>(detected.size());
+
+    return static_cast<int>(references.size()) - 1;
+}
+
+FOCV_FeatureMatch FOCV_FeatureIndex::match(const cv::Mat& frame) {
+    FOCV_FeatureMatch result;
+
+    if (references.empty()) {
+        return result;
+    }
+
+    if (!trained) {
+        train();
+    }
+
+    std::vector<cv::KeyPoint> keypoints;
+    cv::Mat descriptors;
+    detect(frame, keypoints, descriptors);
+
+    if (descriptors.rows < 2) {
+        return result;
+    }
+
+    std::vector<std::vector<cv::DMatch>> knn;
+    matcher->knnMatch(descriptors, knn, 2);
+
+    // Ratio test, grouped by reference
+    std::vector<std::vector<cv::DMatch>> good(references.size());
+    for (const auto& pair : knn) {
+        if (pair.empty()) {
+            continue;
+        }
+
+        // Applied across references too: a feature that matches two similar
+        // references about equally well says nothing about which one is shown
+        bool distinct = pair.size() < 2 || pair[0].distance < options.ratio * pair[1].distance;
+
+        if (distinct) {
+            good[pair[0].imgIdx].push_back(pair[0]);
+        }
+    }
+
+    std::vector<int> order(references.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<int>(i);
+    }
+
+    int candidates = std::min<int>(FOCV_FeatureCandidates, static_cast<int>(order.size()));
+    std::partial_sort(order.begin(), order.begin() + candidates, order.end(), [&](int a, int b) {
+        return good[a].size() > good[b].size();
+    });
+
+    std::vector<cv::Point2f> source;
+    std::vector<cv::Point2f> target;
+    std::vector<uchar> mask;
+
+    for (int c = 0; c < candidates; c++) {
+        int index = order[c];
+        const auto& matches = good[index];
+
+        if (static_cast<int>(matches.size()) < std::max(4, options.minInliers)) {
+            break;
+        }
+
+        source.clear();
+        target.clear();
+        for (const auto& match : matches) {
+            source.push_back(references[index].points[match.trainIdx]);
+            target.push_back(keypoints[match.queryIdx].pt);
+        }
+
+        cv::Mat homography = cv::findHomography(source, target, cv::RANSAC, options.ransacThreshold, mask);
+        if (homography.empty()) {
+            continue;
+        }
+
+        int inliers = cv::countNonZero(mask);
+        if (inliers >= options.minInliers && inliers > result.inliers) {
+            result.reference = index;
+            result.matches = static_cast<int>(matches.size());
+            result.inliers = inliers;
+            result.homography = homography;
+        }
+    }
+
+    if (result.reference >= 0) {
+        cv::Size size = references[result.reference].size;
+        std::vector<cv::Point2f> corners = {
+            cv::Point2f(0, 0),
+            cv::Point2f(size.width, 0),
+            cv::Point2f(size.width, size.height),
+            cv::Point2f(0, size.height),
+        };
+        cv::perspectiveTransform(corners, result.corners, result.homography);
+    }
+
+    return result;
+}
+
+size_t FOCV_FeatureIndex::size() const {
+    return references.size();
+}
+
+// Three Mats per reference: descriptors, keypoint positions (CV_32FC2) and
+// the image size (1x2 CV_32S).
+void FOCV_FeatureIndex::save(const std::string& path) const {
+    std::vector<cv::Mat> mats;
+    mats.reserve(references.size() * 3);
+
+    for (const auto& reference : references) {
+        mats.push_back(reference.descriptors);
+        mats.push_back(cv::Mat(reference.points, false));
+        mats.push_back((cv::Mat_<int32_t>(1, 2) << reference.size.width, reference.size.height));
+    }
+
+    FOCV_MatFile::write(path, FOCV_MatFileKind::FeatureIndex, mats);
+}
+
+void FOCV_FeatureIndex::load(const std::string& path) {
+    std::vector<cv::Mat> mats;
+
+    if (FOCV_MatFile::read(path, mats) != FOCV_MatFileKind::FeatureIndex || mats.size() % 3 != 0) {
+        throw std::runtime_error("Not a feature index file: " + path);
+    }
+
+    std::vector<Reference> loaded(mats.size() / 3);
+
+    for (size_t i = 0; i < loaded.size(); i++) {
+        const cv::Mat& descriptors = mats[i * 3];
+        const cv::Mat& points = mats[i * 3 + 1];
+        const cv::Mat& size = mats[i * 3 + 2];
+
+        // LSH only indexes binary descriptors, and every descriptor row needs its keypoint
+        bool valid = (descriptors.empty() || descriptors.type() == CV_8UC1)
+            && (points.empty() ? descriptors.empty() : points.type() == CV_32FC2 && points.isContinuous() && points.total() == static_cast<size_t>(descriptors.rows))
+            && size.type() == CV_32SC1 && size.total() == 2;
+
+        if (!valid) {
+            throw std::runtime_error("Corrupted feature index file: " + path);
+        }
+
+        // Copied, so that the mapping can be closed
+        loaded[i].descriptors = mats[i * 3].clone();
+        loaded[i].points.assign(points.ptr<cv::Point2f>(), points.ptr<cv::Point2f>() + points.total());
+        loaded[i].size = cv::Size(size.at<int32_t>(0), size.at<int32_t>(1));
+    }
+
+    references = std::move(loaded);
+    trained = false;
+}
@@ -0,0 +1,76 @@
+//
+//  FOCV_FeatureIndex.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_FeatureIndex_hpp
+#define FOCV_FeatureIndex_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+struct FOCV_FeatureIndexOptions {
+    int features = 500;
+    // Lowe's ratio between the best and the second best match, over all references
+    double ratio = 0.75;
+    int minInliers = 12;
+    double ransacThreshold = 5.0;
+};
+
+struct FOCV_FeatureMatch {
+    int reference = -1;
+    int matches = 0;
+    int inliers = 0;
+    cv::Mat homography;
+    std::vector<cv::Point2f> corners;
+};
+
+// ORB descriptors of a set of reference images in an LSH index. A frame is
+// matched against all references at once; the references with the most
+// ratio-test matches are then verified with a RANSAC homography.
+class FOCV_FeatureIndex {
+private:
+    struct Reference {
+        cv::Mat descriptors;
+        std::vector<cv::Point2f> points;
+        cv::Size size;
+    };
+
+    FOCV_FeatureIndexOptions options;
+    cv::Ptr<cv::ORB> orb;
+    cv::Ptr<cv::FlannBasedMatcher> matcher;
+    std::vector<Reference> references;
+    bool trained = false;
+    cv::Mat gray;
+
+    void detect(const cv::Mat& image, std::vector<cv::KeyPoint>& keypoints, cv::Mat& descriptors);
+    void train();
+
+public:
+    FOCV_FeatureIndex(const FOCV_FeatureIndexOptions& options);
+
+    // Returns the id of the reference, which is its position in the index.
+    int add(const cv::Mat& image, int& keypoints);
+    FOCV_FeatureMatch match(const cv::Mat& frame);
+    size_t size() const;
+
+    void save(const std::string& path) const;
+    void load(const std::string& path);
+};
+
+#endif /* FOCV_FeatureIndex_hpp */
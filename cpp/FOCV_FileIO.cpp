@@ -0,0 +1,156 @@
+//
+//  FOCV_FileIO.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_FileIO.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <stdexcept>
+
+FOCV_MappedFile::FOCV_MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Unable to read file " + path);
+    }
+
+    length = info.st_size;
+
+    if (length > 0) {
+        // Private writable mapping: pages are copied on write, the file is never modified
+        address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+
+    if (address == MAP_FAILED) {
+        address = nullptr;
+        throw std::runtime_error("Unable to map file " + path);
+    }
+}
+
+FOCV_MappedFile::~FOCV_MappedFile() {
+    if (address != nullptr) {
+        munmap(address, length);
+    }
+}
+
+const uchar* FOCV_MappedFile::data() const {
+    return static_cast<const uchar*>(address);
+}
+
+size_t FOCV_MappedFile::size() const {
+    return length;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+std::string FOCV_FileIO::normalizePath(const std::string& path) {
+    static const std::string scheme = "file://";
+
+    if (path.compare(0, scheme.size(), scheme) != 0) {
+        return path;
+    }
+
+    // URIs escape spaces and other characters, e.g. the iOS document
+    // directory URI. Plain paths are kept as they are, a % can be part of a name.
+    std::string decoded;
+    decoded.reserve(path.size() - scheme.size());
+
+    for (size_t i = scheme.size(); i < path.size(); i++) {
+        int high = i + 2 < path.size() && path[i] == '%' ? hexValue(path[i + 1]) : -1;
+        int low = high >= 0 ? hexValue(path[i + 2]) : -1;
+
+        if (low >= 0) {
+            decoded.push_back(static_cast<char>(high * 16 + low));
+            i += 2;
+        } else {
+            decoded.push_back(path[i]);
+        }
+    }
+
+    return decoded;
+}
+
+cv::Mat FOCV_FileIO::read(const std::string& path, int flags) {
+    FOCV_MappedFile file(normalizePath(path));
+
+    if (file.size() == 0) {
+        throw std::runtime_error("File is empty: " + path);
+    }
+
+    // imdecode reads the mapped pages directly, without a copy into memory first
+    cv::Mat buffer(1, static_cast<int>(file.size()), CV_8UC1, const_cast<uchar*>(file.data()));
+    cv::Mat mat = cv::imdecode(buffer, flags);
+
+    if (mat.empty()) {
+        throw std::runtime_error("Unable to decode image " + path);
+    }
+
+    return mat;
+}
+
+void FOCV_FileIO::write(const std::string& path, const cv::Mat& mat, const std::vector<int>& params) {
+    std::string target = normalizePath(path);
+    auto extension = target.find_last_of('.');
+
+    if (extension == std::string::npos) {
+        throw std::runtime_error("Missing image extension in " + path);
+    }
+
+    std::vector<uchar> buffer;
+    if (!cv::imencode(target.substr(extension), mat, buffer, params)) {
+        throw std::runtime_error("Unable to encode image " + path);
+    }
+
+    writeBytes(target, buffer.data(), buffer.size());
+}
+
+void FOCV_FileIO::writeBytes(const std::string& path, const uchar* data, size_t length) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open file " + path);
+    }
+
+    size_t written = 0;
+
+    while (written < length) {
+        ssize_t result = ::write(fd, data + written, length - written);
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            close(fd);
+            throw std::runtime_error("Unable to write file " + path);
+        }
+
+        written += result;
+    }
+
+    close(fd);
+}
@@ -0,0 +1,54 @@
+//
+//  FOCV_FileIO.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_FileIO_hpp
+#define FOCV_FileIO_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+// Copy-on-write memory mapping of a whole file, unmapped on destruction.
+class FOCV_MappedFile {
+private:
+    void* address = nullptr;
+    size_t length = 0;
+
+public:
+    explicit FOCV_MappedFile(const std::string& path);
+    ~FOCV_MappedFile();
+
+    FOCV_MappedFile(const FOCV_MappedFile&) = delete;
+    FOCV_MappedFile& operator=(const FOCV_MappedFile&) = delete;
+
+    const uchar* data() const;
+    size_t size() const;
+};
+
+class FOCV_FileIO {
+public:
+    // Accepts plain paths and file:// URIs, whose %XX escapes are decoded.
+    static std::string normalizePath(const std::string& path);
+
+    static cv::Mat read(const std::string& path, int flags);
+    static void write(const std::string& path, const cv::Mat& mat, const std::vector<int>& params);
+    static void writeBytes(const std::string& path, const uchar* data, size_t length);
+};
+
+#endif /* FOCV_FileIO_hpp */
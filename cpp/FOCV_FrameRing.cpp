@@ -0,0 +1,165 @@
+//
+//  FOCV_FrameRing.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_FrameRing.hpp"
+#include <algorithm>
+
+enum class FOCV_RingReduction {
+    Mean,
+    Median,
+    Max,
+    Min,
+};
+
+template <typename T>
+static void reduceRows(const std::vector<cv::Mat>& frames, FOCV_RingReduction operation, cv::Mat& dst, const cv::Range& range) {
+    size_t count = frames.size();
+    int width = frames[0].cols * frames[0].channels();
+    std::vector<const T*> rows(count);
+    std::vector<T> values(count);
+    std::vector<double> sums(operation == FOCV_RingReduction::Mean ? width : 0);
+
+    for (int y = range.start; y < range.end; y++) {
+        for (size_t i = 0; i < count; i++) {
+            rows[i] = frames[i].ptr<T>(y);
+        }
+
+        T* out = dst.ptr<T>(y);
+
+        switch (operation) {
+            case FOCV_RingReduction::Mean: {
+                std::fill(sums.begin(), sums.end(), 0.0);
+                for (size_t i = 0; i < count; i++) {
+                    for (int x = 0; x < width; x++) {
+                        sums[x] += rows[i][x];
+                    }
+                }
+                for (int x = 0; x < width; x++) {
+                    out[x] = cv::saturate_cast<T>(sums[x] / count);
+                }
+            } break;
+            case FOCV_RingReduction::Median: {
+                for (int x = 0; x < width; x++) {
+                    for (size_t i = 0; i < count; i++) {
+                        values[i] = rows[i][x];
+                    }
+                    std::nth_element(values.begin(), values.begin() + count / 2, values.end());
+                    out[x] = values[count / 2];
+                }
+            } break;
+            case FOCV_RingReduction::Max: {
+                std::copy(rows[0], rows[0] + width, out);
+                for (size_t i = 1; i < count; i++) {
+                    for (int x = 0; x < width; x++) {
+                        out[x] = std::max(out[x], rows[i][x]);
+                    }
+                }
+            } break;
+            case FOCV_RingReduction::Min: {
+                std::copy(rows[0], rows[0] + width, out);
+                for (size_t i = 1; i < count; i++) {
+                    for (int x = 0; x < width; x++) {
+                        out[x] = std::min(out[x], rows[i][x]);
+                    }
+                }
+            } break;
+        }
+    }
+}
+
+FOCV_FrameRing::FOCV_FrameRing(int capacity, int rows, int cols, int type) {
+    if (capacity < 1) {
+        throw std::runtime_error("Frame ring capacity must be at least 1");
+    }
+
+    slots.resize(capacity);
+    for (auto& slot : slots) {
+        slot.create(rows, cols, type);
+    }
+}
+
+void FOCV_FrameRing::push(const cv::Mat& frame) {
+    cv::Mat& slot = slots[head];
+
+    if (frame.size() != slot.size() || frame.type() != slot.type()) {
+        throw std::runtime_error("Frame does not match the size and type of the ring");
+    }
+
+    frame.copyTo(slot);
+    head = (head + 1) % slots.size();
+    filled = std::min(filled + 1, slots.size());
+}
+
+void FOCV_FrameRing::push(const uint8_t* data, size_t length) {
+    cv::Mat& slot = slots[head];
+
+    if (length != slot.total() * slot.elemSize()) {
+        throw std::runtime_error("Buffer does not match the size of a ring frame");
+    }
+
+    std::memcpy(slot.data, data, length);
+    head = (head + 1) % slots.size();
+    filled = std::min(filled + 1, slots.size());
+}
+
+cv::Mat FOCV_FrameRing::slot(int offset) const {
+    if (offset < 0 || static_cast<size_t>(offset) >= filled) {
+        throw std::runtime_error("Frame ring holds " + std::to_string(filled) + " frames");
+    }
+
+    return slots[(head + slots.size() - 1 - offset) % slots.size()];
+}
+
+size_t FOCV_FrameRing::size() const {
+    return filled;
+}
+
+size_t FOCV_FrameRing::capacity() const {
+    return slots.size();
+}
+
+void FOCV_FrameRing::reduce(const std::string& operation, int frames, cv::Mat& dst) const {
+    FOCV_RingReduction reduction;
+
+    if (operation == "mean") {
+        reduction = FOCV_RingReduction::Mean;
+    } else if (operation == "median") {
+        reduction = FOCV_RingReduction::Median;
+    } else if (operation == "max") {
+        reduction = FOCV_RingReduction::Max;
+    } else if (operation == "min") {
+        reduction = FOCV_RingReduction::Min;
+    } else {
+        throw std::runtime_error("Unknown frame ring reduction " + operation);
+    }
+
+    size_t count = frames > 0 ? std::min<size_t>(frames, filled) : filled;
+    if (count == 0) {
+        throw std::runtime_error("Frame ring is empty");
+    }
+
+    std::vector<cv::Mat> inputs(count);
+    for (size_t i = 0; i < count; i++) {
+        inputs[i] = slot(static_cast<int>(i));
+    }
+
+    int depth = slots[0].depth();
+    if (depth == CV_8S || depth > CV_64F) {
+        throw std::runtime_error("Unsupported frame ring depth");
+    }
+
+    dst.create(slots[0].size(), slots[0].type());
+
+    cv::parallel_for_(cv::Range(0, dst.rows), [&](const cv::Range& range) {
+        switch (depth) {
+            case CV_8U: reduceRows<uchar>(inputs, reduction, dst, range); break;
+            case CV_16U: reduceRows<ushort>(inputs, reduction, dst, range); break;
+            case CV_16S: reduceRows<short>(inputs, reduction, dst, range); break;
+            case CV_32S: reduceRows<int>(inputs, reduction, dst, range); break;
+            case CV_32F: reduceRows<float>(inputs, reduction, dst, range); break;
+            case CV_64F: reduceRows<double>(inputs, reduction, dst, range); break;
+        }
+    });
+}
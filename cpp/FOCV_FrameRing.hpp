@@ -0,0 +1,53 @@
+//
+//  FOCV_FrameRing.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_FrameRing_hpp
+#define FOCV_FrameRing_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+// Fixed number of preallocated frames of one size and type. Pushing copies
+// into the oldest slot, so no memory is allocated after creation.
+class FOCV_FrameRing {
+private:
+    std::vector<cv::Mat> slots;
+    size_t head = 0;
+    size_t filled = 0;
+
+public:
+    FOCV_FrameRing(int capacity, int rows, int cols, int type);
+
+    void push(const cv::Mat& frame);
+    // Copies raw pixel data of exactly one frame into the next slot.
+    void push(const uint8_t* data, size_t length);
+
+    // 0 is the newest frame, 1 the one before, and so on. The header shares
+    // the slot memory, which is overwritten once the ring wraps around.
+    cv::Mat slot(int offset) const;
+    size_t size() const;
+    size_t capacity() const;
+
+    // Per pixel reduction over the newest `frames` slots (all when <= 0):
+    // "mean", "median", "max" or "min". Rows are processed in parallel.
+    void reduce(const std::string& operation, int frames, cv::Mat& dst) const;
+};
+
+#endif /* FOCV_FrameRing_hpp */
@@ -0,0 +1,78 @@
+//
+//  FOCV_FrameSignature.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_FrameSignature.hpp"
+
+// Pixels sampled per thumbnail cell and axis before area averaging
+static const int FOCV_SignatureSamples = 4;
+
+FOCV_FrameSignature::FOCV_FrameSignature(const FOCV_FrameSignatureOptions& options) : options(options) {
+    if (options.method != "average" && options.method != "difference" && options.method != "thumbnail") {
+        throw std::runtime_error("Unknown frame signature method " + options.method);
+    }
+    if (options.size < 2 || options.size > 64) {
+        throw std::runtime_error("Frame signature size must be between 2 and 64");
+    }
+}
+
+void FOCV_FrameSignature::compute(const cv::Mat& frame) {
+    // The difference hash compares horizontal neighbours, so it needs one more column
+    int width = options.method == "difference" ? options.size + 1 : options.size;
+    int height = options.size;
+
+    // Nearest neighbour sampling only reads the sampled pixels, the area
+    // interpolation of the small result then averages them per cell.
+    cv::Size grid(std::min(frame.cols, width * FOCV_SignatureSamples), std::min(frame.rows, height * FOCV_SignatureSamples));
+    cv::resize(frame, sampled, grid, 0, 0, cv::INTER_NEAREST);
+
+    if (sampled.channels() == 1) {
+        gray = sampled;
+    } else {
+        cv::cvtColor(sampled, gray, sampled.channels() == 4 ? cv::COLOR_RGBA2GRAY : cv::COLOR_RGB2GRAY);
+    }
+
+    cv::resize(gray, thumbnail, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+
+    if (thumbnail.depth() != CV_8U) {
+        cv::normalize(thumbnail, thumbnail, 0, 255, cv::NORM_MINMAX, CV_8U);
+    }
+
+    if (options.method == "thumbnail") {
+        thumbnail.copyTo(signature);
+    } else if (options.method == "average") {
+        cv::compare(thumbnail, cv::mean(thumbnail)[0], signature, cv::CMP_GT);
+    } else {
+        cv::compare(thumbnail.colRange(1, width), thumbnail.colRange(0, width - 1), signature, cv::CMP_GT);
+    }
+}
+
+FOCV_FrameChange FOCV_FrameSignature::compare(const cv::Mat& frame) {
+    compute(frame);
+
+    FOCV_FrameChange change { 1.0, true };
+
+    if (!reference.empty()) {
+        if (options.method == "thumbnail") {
+            change.score = cv::norm(signature, reference, cv::NORM_L1) / (255.0 * signature.total());
+        } else {
+            // Both signatures are 0/255 masks, so differing bits are the non-zero XOR
+            cv::Mat bits;
+            cv::bitwise_xor(signature, reference, bits);
+            change.score = static_cast<double>(cv::countNonZero(bits)) / signature.total();
+        }
+
+        change.changed = change.score >= options.threshold;
+    }
+
+    if (change.changed) {
+        signature.copyTo(reference);
+    }
+
+    return change;
+}
+
+void FOCV_FrameSignature::reset() {
+    reference.release();
+}
@@ -0,0 +1,65 @@
+//
+//  FOCV_FrameSignature.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_FrameSignature_hpp
+#define FOCV_FrameSignature_hpp
+
+#include <stdio.h>
+#include <string>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+struct FOCV_FrameSignatureOptions {
+    // average, difference or thumbnail
+    std::string method = "difference";
+    // Side of the hash grid (average, difference) or of the thumbnail
+    int size = 8;
+    // Frames scoring below this are reported as unchanged
+    double threshold = 0.05;
+};
+
+struct FOCV_FrameChange {
+    // 0 for identical signatures, 1 for completely different ones
+    double score;
+    bool changed;
+};
+
+// Tiny signature of the last changed frame, to skip processing of frames that
+// are nearly identical to it. Frames are sampled on a sparse grid before the
+// signature is computed, so the cost does not depend on the frame size.
+class FOCV_FrameSignature {
+private:
+    FOCV_FrameSignatureOptions options;
+    cv::Mat sampled;
+    cv::Mat gray;
+    cv::Mat thumbnail;
+    cv::Mat signature;
+    cv::Mat reference;
+
+    void compute(const cv::Mat& frame);
+
+public:
+    FOCV_FrameSignature(const FOCV_FrameSignatureOptions& options);
+
+    // The reference signature is only replaced when the frame is reported as
+    // changed, so slow drift still adds up to a change. The first frame is
+    // always changed.
+    FOCV_FrameChange compare(const cv::Mat& frame);
+    void reset();
+};
+
+#endif /* FOCV_FrameSignature_hpp */
@@ -11,6 +11,12 @@
 #include <FOCV_JsiObject.hpp>
 #include <opencv2/opencv.hpp>
 #include "FOCV_FunctionArguments.hpp"
+#include "FOCV_Contours.hpp"
+#include "FOCV_Document.hpp"
+#include "FOCV_Trace.hpp"
+#include "jsi/TypedArray.h"
+
+using namespace mrousavy;
 
 // General idea and this function for hashing is from
 // https://mrousavy.com/blog/Hashing-String-Ifs
@@ -29,11 +35,70 @@ constexpr uint64_t hashString(const char* str, size_t length) {
 // General idea of invocation switch is from react-native-opencv3 library,
 // but it was adapted and optimized.
 jsi::Object FOCV_Function::invoke(jsi::Runtime& runtime, const jsi::Value* arguments) {
-    jsi::Object value(runtime);
-    
     FOCV_FunctionArguments args(runtime, arguments);
+
+    return invoke(runtime, args);
+}
+
+// arguments: roi (rect, or mask Mat whose non-zero bounding box is used), then
+// the same arguments as invoke. The first non-empty Mat argument defines the
+// full image size.
+jsi::Object FOCV_Function::invokeWithRoi(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+    FOCV_FunctionArguments args(runtime, arguments + 1);
+
+    cv::Size source;
+
+    for (size_t i = 2; i < count; i++) {
+        if (!arguments[i].isObject() || !arguments[i].asObject(runtime).hasProperty(runtime, "type")) {
+            continue;
+        }
+
+        if (FOCV_JsiObject::type_from_wrap(runtime, arguments[i]) == "mat") {
+            auto mat = FOCV_Storage::get<cv::Mat>(FOCV_JsiObject::id_from_wrap(runtime, arguments[i]));
+
+            if (!mat->empty()) {
+                source = mat->size();
+                break;
+            }
+        }
+    }
+
+    if (source.empty()) {
+        return invoke(runtime, args);
+    }
+
+    std::string roiType = FOCV_JsiObject::type_from_wrap(runtime, arguments[0]);
+    std::string roiId = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
+    cv::Rect roi;
+
+    if (roiType == "rect") {
+        roi = *FOCV_Storage::get<cv::Rect>(roiId);
+    } else if (roiType == "mat") {
+        auto mask = FOCV_Storage::get<cv::Mat>(roiId);
+        roi = mask->empty() ? cv::Rect({}, source) : cv::boundingRect(*mask);
+    } else {
+        throw std::runtime_error("ROI must be a rect or a mask Mat");
+    }
+
+    roi &= cv::Rect({}, source);
+
+    // Nothing to process, e.g. an empty mask
+    if (roi.empty()) {
+        return jsi::Object(runtime);
+    }
+
+    args.setRoi(roi, source);
+    auto result = invoke(runtime, args);
+    args.commitRoi();
+
+    return result;
+}
+
+jsi::Object FOCV_Function::invoke(jsi::Runtime& runtime, FOCV_FunctionArguments& args) {
+    jsi::Object value(runtime);
     
     std::string functionName = args.asString(0);
+    FOCV_TraceScope trace("invoke", functionName);
     
     switch (hashString(functionName.c_str(), functionName.size())) {
         case hashString("absdiff", 7): {
@@ -1309,6 +1374,33 @@ jsi::Object FOCV_Function::invoke(jsi::Runtime& runtime, const jsi::Value* argum
                 cv::warpAffine(*src, *dst, *m, *dsize);
             }
         } break;
+        case hashString("warpPerspective", 15): {
+            auto src = args.asMatPtr(1);
+            auto dst = args.asMatPtr(2);
+            auto m = args.asMatPtr(3);
+            auto dsize = args.asSizePtr(4);
+
+            if (args.isNumber(6)) {
+                auto flags = args.asNumber(5);
+                auto borderMode = args.asNumber(6);
+
+                cv::warpPerspective(*src, *dst, *m, *dsize, flags, borderMode);
+            } else if (args.isNumber(5)) {
+                auto flags = args.asNumber(5);
+                cv::warpPerspective(*src, *dst, *m, *dsize, flags);
+            } else {
+                cv::warpPerspective(*src, *dst, *m, *dsize);
+            }
+        } break;
+        case hashString("getPerspectiveTransform", 23): {
+            auto src = args.asMatPtr(1);
+            auto dst = args.asMatPtr(2);
+
+            auto result = cv::getPerspectiveTransform(*src, *dst);
+            std::string id = FOCV_Storage::save(result);
+
+            return FOCV_JsiObject::wrap(runtime, "mat", id);
+        } break;
         case hashString("getRotationMatrix2D", 19): {
             auto center = args.asPointPtr(1);
             auto angle = args.asNumber(2);
@@ -1523,6 +1615,318 @@ jsi::Object FOCV_Function::invoke(jsi::Runtime& runtime, const jsi::Value* argum
             // Convert to CV_8U format
             clamped.convertTo(*dst, CV_8U);
         } break;
+        case hashString("calcOpticalFlowPyrLK", 20): {
+            auto prevImg = args.asMatPtr(1);
+            auto nextImg = args.asMatPtr(2);
+            auto prevPts = args.asMatPtr(3);
+            auto nextPts = args.asMatPtr(4);
+            auto status = args.asMatPtr(5);
+            auto err = args.asMatPtr(6);
+
+            if(args.isNumber(8)) {
+                auto winSize = args.asSizePtr(7);
+                auto maxLevel = args.asNumber(8);
+
+                cv::calcOpticalFlowPyrLK(*prevImg, *nextImg, *prevPts, *nextPts, *status, *err, *winSize, maxLevel);
+            } else {
+                cv::calcOpticalFlowPyrLK(*prevImg, *nextImg, *prevPts, *nextPts, *status, *err);
+            }
+        } break;
+        case hashString("trackPoints", 11): {
+            auto tracker = args.asPointTrackerPtr(1);
+            auto frame = args.asMatPtr(2);
+
+            tracker->track(*frame);
+
+            auto count = tracker->points.size();
+            auto points = TypedArray<TypedArrayKind::Float32Array>(runtime, count * 2);
+            auto ids = TypedArray<TypedArrayKind::Int32Array>(runtime, count);
+
+            points.updateUnsafe(runtime, reinterpret_cast<float*>(tracker->points.data()), count * sizeof(cv::Point2f));
+            ids.updateUnsafe(runtime, tracker->ids.data(), count * sizeof(int32_t));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(count)));
+            value.setProperty(runtime, "points", points);
+            value.setProperty(runtime, "ids", ids);
+        } break;
+        case hashString("updateObjectTracker", 19): {
+            auto tracker = args.asObjectTrackerPtr(1);
+
+            if (args.isRectVector(2)) {
+                auto detections = args.asRectVectorPtr(2);
+                auto scores = args.isFloatVector(3) ? args.asFloatVector(3) : std::vector<float>();
+
+                tracker->update(detections.get(), scores);
+            } else {
+                tracker->update(nullptr, {});
+            }
+
+            std::vector<int32_t> ids;
+            std::vector<FOCV_TrackedObject> objects;
+            tracker->objects(ids, objects);
+
+            auto idBuffer = TypedArray<TypedArrayKind::Int32Array>(runtime, ids.size());
+            auto trackBuffer = TypedArray<TypedArrayKind::Float32Array>(runtime, objects.size() * 6);
+
+            idBuffer.updateUnsafe(runtime, ids.data(), ids.size() * sizeof(int32_t));
+            trackBuffer.updateUnsafe(runtime, reinterpret_cast<float*>(objects.data()), objects.size() * sizeof(FOCV_TrackedObject));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(ids.size())));
+            value.setProperty(runtime, "ids", idBuffer);
+            value.setProperty(runtime, "tracks", trackBuffer);
+        } break;
+        case hashString("resetObjectTracker", 18): {
+            auto tracker = args.asObjectTrackerPtr(1);
+
+            tracker->reset();
+        } break;
+        case hashString("pushFrameRing", 13): {
+            auto ring = args.asFrameRingPtr(1);
+
+            if (args.isTypedArray(2)) {
+                size_t length = 0;
+                auto data = args.asTypedArrayData(2, length);
+
+                ring->push(data, length);
+            } else {
+                ring->push(*args.asMatPtr(2));
+            }
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(ring->size())));
+        } break;
+        case hashString("getFrameRingSlot", 16): {
+            auto ring = args.asFrameRingPtr(1);
+            auto offset = args.isNumber(2) ? args.asNumber(2) : 0;
+
+            cv::Mat slot = ring->slot(offset);
+            std::string id = FOCV_Storage::save(slot);
+
+            return FOCV_JsiObject::wrap(runtime, "mat", id);
+        } break;
+        case hashString("reduceFrameRing", 15): {
+            auto ring = args.asFrameRingPtr(1);
+            auto dst = args.asMatPtr(2);
+            auto operation = args.asString(3);
+            auto frames = args.isNumber(4) ? args.asNumber(4) : 0;
+
+            ring->reduce(operation, frames, *dst);
+        } break;
+        case hashString("compareFrameSignature", 21): {
+            auto signature = args.asFrameSignaturePtr(1);
+            auto frame = args.asMatPtr(2);
+
+            auto change = signature->compare(*frame);
+
+            value.setProperty(runtime, "score", jsi::Value(change.score));
+            value.setProperty(runtime, "changed", jsi::Value(change.changed));
+        } break;
+        case hashString("resetFrameSignature", 19): {
+            auto signature = args.asFrameSignaturePtr(1);
+
+            signature->reset();
+        } break;
+        case hashString("resetPointTracker", 17): {
+            auto tracker = args.asPointTrackerPtr(1);
+
+            tracker->reset();
+        } break;
+        case hashString("applyBackgroundModel", 20): {
+            auto model = args.asBackgroundModelPtr(1);
+            auto frame = args.asMatPtr(2);
+            auto mask = args.asMatPtr(3);
+
+            std::vector<cv::Rect> rects;
+            model->apply(*frame, *mask, rects);
+
+            auto buffer = TypedArray<TypedArrayKind::Int32Array>(runtime, rects.size() * 4);
+            buffer.updateUnsafe(runtime, reinterpret_cast<int32_t*>(rects.data()), rects.size() * sizeof(cv::Rect));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(rects.size())));
+            value.setProperty(runtime, "rects", buffer);
+        } break;
+        case hashString("matchTemplates", 14): {
+            auto templates = args.asTemplateSetPtr(1);
+            auto image = args.asMatPtr(2);
+            auto threshold = args.asNumber(3);
+            auto maxMatches = args.asNumber(4);
+            auto overlap = args.isNumber(5) ? args.asNumber(5) : 0.3;
+
+            auto matches = templates->match(*image, threshold, maxMatches, overlap);
+
+            auto buffer = TypedArray<TypedArrayKind::Float32Array>(runtime, matches.size() * 7);
+            buffer.updateUnsafe(runtime, reinterpret_cast<float*>(matches.data()), matches.size() * sizeof(FOCV_TemplateMatch));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(matches.size())));
+            value.setProperty(runtime, "matches", buffer);
+        } break;
+        case hashString("filterContours", 14): {
+            auto contours = args.asMatVectorPtr(1);
+
+            FOCV_ContourFilter options;
+            if (args.isNumber(2)) options.minArea = args.asNumber(2);
+            if (args.isNumber(3)) options.maxArea = args.asNumber(3);
+            if (args.isNumber(4)) options.minVertices = args.asNumber(4);
+            if (args.isNumber(5)) options.maxVertices = args.asNumber(5);
+            if (args.isNumber(6)) options.minAspect = args.asNumber(6);
+            if (args.isNumber(7)) options.maxAspect = args.asNumber(7);
+            if (args.isNumber(8)) options.minSolidity = args.asNumber(8);
+            if (args.isNumber(9)) options.topK = args.asNumber(9);
+            if (args.isNumber(10)) options.sortBy = static_cast<FOCV_ContourSortKey>(args.asNumber(10));
+            if (args.isNumber(11)) options.epsilon = args.asNumber(11);
+
+            std::vector<FOCV_ContourMetrics> metrics;
+            if (args.isMatVector(12)) {
+                metrics = FOCV_Contours::filter(*contours, options, args.asMatVectorPtr(12).get());
+            } else {
+                metrics = FOCV_Contours::filter(*contours, options);
+            }
+
+            auto buffer = TypedArray<TypedArrayKind::Float32Array>(runtime, metrics.size() * 10);
+            buffer.updateUnsafe(runtime, reinterpret_cast<float*>(metrics.data()), metrics.size() * sizeof(FOCV_ContourMetrics));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(metrics.size())));
+            value.setProperty(runtime, "metrics", buffer);
+        } break;
+        case hashString("detectDirtyTiles", 16): {
+            auto tracker = args.asDirtyTrackerPtr(1);
+            auto frame = args.asMatPtr(2);
+            auto regions = args.asRectVectorPtr(3);
+
+            int count = tracker->detect(*frame, *regions);
+
+            value.setProperty(runtime, "count", jsi::Value(count));
+        } break;
+        case hashString("resetDirtyTracker", 17): {
+            auto tracker = args.asDirtyTrackerPtr(1);
+
+            tracker->reset();
+        } break;
+        case hashString("detectDocumentQuad", 18): {
+            auto src = args.asMatPtr(1);
+            auto workingSize = args.isNumber(2) ? args.asNumber(2) : 400;
+            auto minAreaRatio = args.isNumber(3) ? args.asNumber(3) : 0.2;
+
+            FOCV_Quad corners;
+            bool found = FOCV_Document::detectQuad(*src, workingSize, minAreaRatio, corners);
+
+            value.setProperty(runtime, "found", jsi::Value(found));
+
+            if (found) {
+                cv::Mat cornersMat(4, 1, CV_32FC2, corners.data());
+                cv::Mat stored = cornersMat.clone();
+                std::string id = FOCV_Storage::save(stored);
+
+                auto buffer = TypedArray<TypedArrayKind::Float32Array>(runtime, 8);
+                buffer.updateUnsafe(runtime, reinterpret_cast<float*>(corners.data()), sizeof(FOCV_Quad));
+
+                value.setProperty(runtime, "corners", FOCV_JsiObject::wrap(runtime, "mat", id));
+                value.setProperty(runtime, "points", buffer);
+            }
+        } break;
+        case hashString("rectifyDocument", 15): {
+            auto src = args.asMatPtr(1);
+            auto dst = args.asMatPtr(2);
+            auto cornersMat = args.asMatPtr(3);
+
+            cv::Mat points;
+            cornersMat->convertTo(points, CV_32F);
+
+            if (points.total() * points.channels() != 8) {
+                throw std::runtime_error("Document corners must hold 4 points");
+            }
+
+            FOCV_Quad corners;
+            std::memcpy(corners.data(), points.reshape(1, 8).ptr<float>(), sizeof(FOCV_Quad));
+
+            cv::Size size = args.isNumber(5)
+                ? cv::Size(args.asNumber(4), args.asNumber(5))
+                : FOCV_Document::rectifiedSize(corners);
+
+            FOCV_Document::rectify(*src, corners, size, *dst);
+        } break;
+        case hashString("setRemapWarp", 12): {
+            auto transform = args.asRemapTransformPtr(1);
+            auto m = args.asMatPtr(2);
+            auto dsize = args.asSizePtr(3);
+
+            value.setProperty(runtime, "rebuilt", jsi::Value(transform->setWarp(*m, *dsize)));
+        } break;
+        case hashString("setRemapUndistort", 17): {
+            auto transform = args.asRemapTransformPtr(1);
+            auto cameraMatrix = args.asMatPtr(2);
+            auto distCoeffs = args.asMatPtr(3);
+            auto dsize = args.asSizePtr(4);
+
+            cv::Mat newCameraMatrix;
+            if (args.isMat(5)) {
+                newCameraMatrix = *args.asMatPtr(5);
+            }
+
+            value.setProperty(runtime, "rebuilt", jsi::Value(transform->setUndistort(*cameraMatrix, *distCoeffs, newCameraMatrix, *dsize)));
+        } break;
+        case hashString("setRemapMesh", 12): {
+            auto transform = args.asRemapTransformPtr(1);
+            auto mesh = args.asMatPtr(2);
+            auto dsize = args.asSizePtr(3);
+
+            value.setProperty(runtime, "rebuilt", jsi::Value(transform->setMesh(*mesh, *dsize)));
+        } break;
+        case hashString("applyRemap", 10): {
+            auto transform = args.asRemapTransformPtr(1);
+            auto src = args.asMatPtr(2);
+            auto dst = args.asMatPtr(3);
+            auto interpolation = args.isNumber(4) ? args.asNumber(4) : cv::INTER_LINEAR;
+            auto borderMode = args.isNumber(5) ? args.asNumber(5) : cv::BORDER_CONSTANT;
+
+            transform->apply(*src, *dst, interpolation, borderMode);
+        } break;
+        case hashString("addFeatureReference", 19): {
+            auto index = args.asFeatureIndexPtr(1);
+            auto image = args.asMatPtr(2);
+
+            int keypoints = 0;
+            int id = index->add(*image, keypoints);
+
+            value.setProperty(runtime, "id", jsi::Value(id));
+            value.setProperty(runtime, "keypoints", jsi::Value(keypoints));
+        } break;
+        case hashString("matchFeatureIndex", 17): {
+            auto index = args.asFeatureIndexPtr(1);
+            auto frame = args.asMatPtr(2);
+
+            auto match = index->match(*frame);
+
+            value.setProperty(runtime, "id", jsi::Value(match.reference));
+            value.setProperty(runtime, "matches", jsi::Value(match.matches));
+            value.setProperty(runtime, "inliers", jsi::Value(match.inliers));
+
+            if (match.reference >= 0) {
+                cv::Mat homography;
+                match.homography.convertTo(homography, CV_32F);
+
+                auto matrix = TypedArray<TypedArrayKind::Float32Array>(runtime, 9);
+                matrix.updateUnsafe(runtime, homography.ptr<float>(), 9 * sizeof(float));
+
+                auto corners = TypedArray<TypedArrayKind::Float32Array>(runtime, 8);
+                corners.updateUnsafe(runtime, reinterpret_cast<float*>(match.corners.data()), 8 * sizeof(float));
+
+                value.setProperty(runtime, "homography", matrix);
+                value.setProperty(runtime, "corners", corners);
+            }
+        } break;
+        case hashString("saveFeatureIndex", 16): {
+            auto index = args.asFeatureIndexPtr(1);
+            auto path = args.asString(2);
+
+            index->save(path);
+        } break;
+        case hashString("loadFeatureIndex", 16): {
+            auto index = args.asFeatureIndexPtr(1);
+            auto path = args.asString(2);
+
+            index->load(path);
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(index->size())));
+        } break;
     }
     
     return value;
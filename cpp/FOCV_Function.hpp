@@ -11,6 +11,7 @@
 #include <jsi/jsilib.h>
 #include <jsi/jsi.h>
 #include <stdio.h>
+#include "FOCV_FunctionArguments.hpp"
 
 #ifdef __cplusplus
 #undef YES
@@ -31,6 +32,10 @@ using namespace facebook;
 class FOCV_Function {
 public:
     static jsi::Object invoke(jsi::Runtime& runtime, const jsi::Value* arguments);
+    static jsi::Object invokeWithRoi(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+
+private:
+    static jsi::Object invoke(jsi::Runtime& runtime, FOCV_FunctionArguments& args);
 };
 
 
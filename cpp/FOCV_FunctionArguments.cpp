@@ -9,6 +9,9 @@
 #include <opencv2/opencv.hpp>
 #include "FOCV_Storage.hpp"
 #include "FOCV_JsiObject.hpp"
+#include "jsi/TypedArray.h"
+
+using namespace mrousavy;
 
 FOCV_FunctionArguments::FOCV_FunctionArguments(jsi::Runtime& runtime, const jsi::Value* arguments) {
     this->arguments = arguments;
@@ -27,8 +30,84 @@ std::string FOCV_FunctionArguments::asString(int index) {
     return this->arguments[index].asString(*this->runtime).utf8(*this->runtime);
 }
 
+uint8_t* FOCV_FunctionArguments::asTypedArrayData(int index, size_t& length) {
+    TypedArrayBase array(*this->runtime, this->arguments[index].asObject(*this->runtime));
+
+    length = array.byteLength(*this->runtime);
+    return array.getBuffer(*this->runtime).data(*this->runtime) + array.byteOffset(*this->runtime);
+}
+
+std::vector<float> FOCV_FunctionArguments::asFloatVector(int index) {
+    auto object = this->arguments[index].asObject(*this->runtime);
+
+    if (mrousavy::isTypedArray(*this->runtime, object)) {
+        TypedArrayBase array(*this->runtime, object);
+
+        if (array.getKind(*this->runtime) != TypedArrayKind::Float32Array) {
+            throw std::runtime_error("Expected a Float32Array");
+        }
+
+        return array.toVector32F(*this->runtime);
+    }
+
+    auto array = object.asArray(*this->runtime);
+    std::vector<float> result(array.size(*this->runtime));
+
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = array.getValueAtIndex(*this->runtime, i).asNumber();
+    }
+
+    return result;
+}
+
+void FOCV_FunctionArguments::setRoi(const cv::Rect& roi, const cv::Size& source) {
+    this->hasRoi = true;
+    this->roi = roi;
+    this->roiSource = source;
+}
+
+void FOCV_FunctionArguments::commitRoi() {
+    for (auto& view : views) {
+        if (view.view->data == view.data) {
+            continue;
+        }
+
+        // The function reallocated the header, so the result no longer lives in
+        // the parent. Only a result that fits the region as it is can be placed
+        // back without touching the caller's pixels outside of it.
+        if (view.view->size() != roi.size()) {
+            views.clear();
+            throw std::runtime_error("The function changed the size of a region output");
+        }
+
+        if (view.view->type() != view.mat->type()) {
+            views.clear();
+            throw std::runtime_error("The function changed the type of a region output");
+        }
+
+        view.view->copyTo((*view.mat)(roi));
+    }
+
+    views.clear();
+}
+
 std::shared_ptr<cv::Mat> FOCV_FunctionArguments::asMatPtr(int index) {
-    return FOCV_Storage::get<cv::Mat>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+    auto mat = FOCV_Storage::get<cv::Mat>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+
+    if (!hasRoi || mat->empty() || mat->size() != roiSource) {
+        return mat;
+    }
+
+    for (auto& view : views) {
+        if (view.mat == mat) {
+            return view.view;
+        }
+    }
+
+    auto view = std::make_shared<cv::Mat>((*mat)(roi));
+    views.push_back({ mat, view, view->data });
+
+    return view;
 }
 
 std::shared_ptr<std::vector<cv::Mat>> FOCV_FunctionArguments::asMatVectorPtr(int index) {
@@ -63,6 +142,42 @@ std::shared_ptr<cv::RotatedRect> FOCV_FunctionArguments::asRotatedRectPtr(int in
     return FOCV_Storage::get<cv::RotatedRect>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
 }
 
+std::shared_ptr<FOCV_PointTracker> FOCV_FunctionArguments::asPointTrackerPtr(int index) {
+    return FOCV_Storage::get<FOCV_PointTracker>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_BackgroundModel> FOCV_FunctionArguments::asBackgroundModelPtr(int index) {
+    return FOCV_Storage::get<FOCV_BackgroundModel>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_TemplateSet> FOCV_FunctionArguments::asTemplateSetPtr(int index) {
+    return FOCV_Storage::get<FOCV_TemplateSet>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_RemapTransform> FOCV_FunctionArguments::asRemapTransformPtr(int index) {
+    return FOCV_Storage::get<FOCV_RemapTransform>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_FeatureIndex> FOCV_FunctionArguments::asFeatureIndexPtr(int index) {
+    return FOCV_Storage::get<FOCV_FeatureIndex>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_ObjectTracker> FOCV_FunctionArguments::asObjectTrackerPtr(int index) {
+    return FOCV_Storage::get<FOCV_ObjectTracker>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_FrameRing> FOCV_FunctionArguments::asFrameRingPtr(int index) {
+    return FOCV_Storage::get<FOCV_FrameRing>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_FrameSignature> FOCV_FunctionArguments::asFrameSignaturePtr(int index) {
+    return FOCV_Storage::get<FOCV_FrameSignature>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
+std::shared_ptr<FOCV_DirtyTracker> FOCV_FunctionArguments::asDirtyTrackerPtr(int index) {
+    return FOCV_Storage::get<FOCV_DirtyTracker>(FOCV_JsiObject::id_from_wrap(*this->runtime, arguments[index]));
+}
+
 bool FOCV_FunctionArguments::isNumber(int index) {
     return this->arguments[index].isNumber();
 }
@@ -80,5 +195,26 @@ bool FOCV_FunctionArguments::isObject(int index) {
 }
 
 bool FOCV_FunctionArguments::isMat(int index) {
-    return FOCV_JsiObject::type_from_wrap(*this->runtime, arguments[index]) == "mat";
+    return arguments[index].isObject() && FOCV_JsiObject::type_from_wrap(*this->runtime, arguments[index]) == "mat";
+}
+
+bool FOCV_FunctionArguments::isMatVector(int index) {
+    return arguments[index].isObject() && FOCV_JsiObject::type_from_wrap(*this->runtime, arguments[index]) == "mat_vector";
+}
+
+bool FOCV_FunctionArguments::isRectVector(int index) {
+    return arguments[index].isObject() && FOCV_JsiObject::type_from_wrap(*this->runtime, arguments[index]) == "rect_vector";
+}
+
+bool FOCV_FunctionArguments::isFloatVector(int index) {
+    if (!arguments[index].isObject()) {
+        return false;
+    }
+
+    auto object = arguments[index].asObject(*this->runtime);
+    return object.isArray(*this->runtime) || mrousavy::isTypedArray(*this->runtime, object);
+}
+
+bool FOCV_FunctionArguments::isTypedArray(int index) {
+    return arguments[index].isObject() && mrousavy::isTypedArray(*this->runtime, arguments[index].asObject(*this->runtime));
 }
@@ -11,6 +11,15 @@
 #include <jsi/jsilib.h>
 #include <jsi/jsi.h>
 #include <stdio.h>
+#include "FOCV_PointTracker.hpp"
+#include "FOCV_BackgroundModel.hpp"
+#include "FOCV_TemplateSet.hpp"
+#include "FOCV_RemapTransform.hpp"
+#include "FOCV_FeatureIndex.hpp"
+#include "FOCV_ObjectTracker.hpp"
+#include "FOCV_FrameRing.hpp"
+#include "FOCV_FrameSignature.hpp"
+#include "FOCV_DirtyTracker.hpp"
 
 #ifdef __cplusplus
 #undef YES
@@ -28,16 +37,39 @@ using namespace cv;
 
 using namespace facebook;
 
+struct FOCV_RoiView {
+    std::shared_ptr<cv::Mat> mat;
+    std::shared_ptr<cv::Mat> view;
+    uchar* data;
+};
+
 class FOCV_FunctionArguments {
 private:
     const jsi::Value* arguments;
     jsi::Runtime* runtime;
 
+    bool hasRoi = false;
+    cv::Rect roi;
+    cv::Size roiSource;
+    std::vector<FOCV_RoiView> views;
+
 public:
     FOCV_FunctionArguments(jsi::Runtime& runtime, const jsi::Value* arguments);
+
+    // After `setRoi`, every Mat of the `source` size is handed out as a `roi`
+    // header sharing its data. Other Mats (empty outputs, masks, kernels) are
+    // handed out unchanged.
+    void setRoi(const cv::Rect& roi, const cv::Size& source);
+    // Stores the result of outputs that could not be written in place.
+    void commitRoi();
+
     double asNumber(int index);
     bool asBool(int index);
     std::string asString(int index);
+    // Float32Array or number[]
+    std::vector<float> asFloatVector(int index);
+    // Raw bytes of a TypedArray, without copying
+    uint8_t* asTypedArrayData(int index, size_t& length);
     
     std::shared_ptr<cv::Mat> asMatPtr(int index);
     std::shared_ptr<std::vector<cv::Mat>> asMatVectorPtr(int index);
@@ -48,12 +80,25 @@ public:
     std::shared_ptr<cv::Size> asSizePtr(int index);
     std::shared_ptr<cv::Scalar> asScalarPtr(int index);
     std::shared_ptr<cv::RotatedRect> asRotatedRectPtr(int index);
+    std::shared_ptr<FOCV_PointTracker> asPointTrackerPtr(int index);
+    std::shared_ptr<FOCV_BackgroundModel> asBackgroundModelPtr(int index);
+    std::shared_ptr<FOCV_TemplateSet> asTemplateSetPtr(int index);
+    std::shared_ptr<FOCV_RemapTransform> asRemapTransformPtr(int index);
+    std::shared_ptr<FOCV_FeatureIndex> asFeatureIndexPtr(int index);
+    std::shared_ptr<FOCV_ObjectTracker> asObjectTrackerPtr(int index);
+    std::shared_ptr<FOCV_FrameRing> asFrameRingPtr(int index);
+    std::shared_ptr<FOCV_FrameSignature> asFrameSignaturePtr(int index);
+    std::shared_ptr<FOCV_DirtyTracker> asDirtyTrackerPtr(int index);
     
     bool isNumber(int index);
     bool isBool(int index);
     bool isString(int index);
     bool isObject(int index);
     bool isMat(int index);
+    bool isMatVector(int index);
+    bool isRectVector(int index);
+    bool isFloatVector(int index);
+    bool isTypedArray(int index);
 };
 
 #endif /* FOCV_FunctionArguments_hpp */
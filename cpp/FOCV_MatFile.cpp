@@ -0,0 +1,177 @@
+//
+//  FOCV_MatFile.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_MatFile.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + FOCV_MatFileAlignment - 1) / FOCV_MatFileAlignment * FOCV_MatFileAlignment;
+}
+
+// Allocator of Mats over a mapped file. The UMatData keeps a reference to the
+// mapping, so the pages are unmapped when the last Mat using them is released.
+// New allocations on such a Mat (e.g. `create` with another size) go to the
+// standard allocator.
+class FOCV_MappedAllocator : public cv::MatAllocator {
+public:
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override {
+        return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(cv::UMatData* u, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override {
+        return cv::Mat::getStdAllocator()->allocate(u, flags, usageFlags);
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (u == nullptr || u->refcount != 0) {
+            return;
+        }
+
+        delete static_cast<std::shared_ptr<FOCV_MappedFile>*>(u->userdata);
+        delete u;
+    }
+
+    cv::Mat wrap(const std::shared_ptr<FOCV_MappedFile>& mapping, int dims, const int* sizes, int type, uchar* data, size_t length) const {
+        cv::Mat mat(dims, sizes, type, data);
+
+        auto u = new cv::UMatData(this);
+        u->data = u->origdata = data;
+        u->size = length;
+        u->userdata = new std::shared_ptr<FOCV_MappedFile>(mapping);
+
+        mat.u = u;
+        mat.allocator = const_cast<FOCV_MappedAllocator*>(this);
+        mat.addref();
+
+        return mat;
+    }
+};
+
+static FOCV_MappedAllocator mappedAllocator;
+
+void FOCV_MatFile::write(const std::string& path, FOCV_MatFileKind kind, const std::vector<cv::Mat>& mats) {
+    std::vector<cv::Mat> continuous(mats.size());
+    std::vector<FOCV_MatFileEntry> entries(mats.size());
+    uint64_t offset = alignOffset(sizeof(FOCV_MatFileHeader) + entries.size() * sizeof(FOCV_MatFileEntry));
+
+    for (size_t i = 0; i < mats.size(); i++) {
+        if (mats[i].dims > FOCV_MatFileMaxDims) {
+            throw std::runtime_error("Mats with more than 8 dimensions can't be saved");
+        }
+
+        continuous[i] = mats[i].isContinuous() ? mats[i] : mats[i].clone();
+
+        auto& mat = continuous[i];
+        auto& entry = entries[i];
+
+        memset(&entry, 0, sizeof(FOCV_MatFileEntry));
+        entry.type = mat.type();
+        entry.dims = mat.dims;
+        for (int d = 0; d < mat.dims; d++) {
+            entry.sizes[d] = mat.size[d];
+            entry.steps[d] = mat.step[d];
+        }
+        entry.offset = offset;
+        entry.length = mat.total() * mat.elemSize();
+
+        offset = alignOffset(offset + entry.length);
+    }
+
+    FOCV_MatFileHeader header;
+    memcpy(header.magic, FOCV_MatFileMagic, sizeof(FOCV_MatFileMagic));
+    header.version = FOCV_MatFileVersion;
+    header.kind = static_cast<uint32_t>(kind);
+    header.count = static_cast<uint32_t>(mats.size());
+    header.reserved = 0;
+
+    std::ofstream file(FOCV_FileIO::normalizePath(path), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open file " + path);
+    }
+
+    static const char padding[FOCV_MatFileAlignment] = {};
+    uint64_t position = sizeof(FOCV_MatFileHeader) + entries.size() * sizeof(FOCV_MatFileEntry);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(FOCV_MatFileHeader));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(FOCV_MatFileEntry));
+
+    for (size_t i = 0; i < continuous.size(); i++) {
+        file.write(padding, entries[i].offset - position);
+        file.write(reinterpret_cast<const char*>(continuous[i].data), entries[i].length);
+        position = entries[i].offset + entries[i].length;
+    }
+
+    if (!file.good()) {
+        throw std::runtime_error("Unable to write file " + path);
+    }
+}
+
+FOCV_MatFileKind FOCV_MatFile::read(const std::string& path, std::vector<cv::Mat>& mats) {
+    auto mapping = std::make_shared<FOCV_MappedFile>(FOCV_FileIO::normalizePath(path));
+
+    const uchar* data = mapping->data();
+    size_t size = mapping->size();
+
+    if (size < sizeof(FOCV_MatFileHeader)) {
+        throw std::runtime_error("Not a Mat file: " + path);
+    }
+
+    FOCV_MatFileHeader header;
+    memcpy(&header, data, sizeof(FOCV_MatFileHeader));
+
+    if (memcmp(header.magic, FOCV_MatFileMagic, sizeof(FOCV_MatFileMagic)) != 0) {
+        throw std::runtime_error("Not a Mat file: " + path);
+    }
+
+    if (header.version != FOCV_MatFileVersion) {
+        throw std::runtime_error("Unsupported Mat file version in " + path);
+    }
+
+    if (header.count > (size - sizeof(FOCV_MatFileHeader)) / sizeof(FOCV_MatFileEntry)) {
+        throw std::runtime_error("Corrupted Mat file: " + path);
+    }
+
+    const auto* entries = reinterpret_cast<const FOCV_MatFileEntry*>(data + sizeof(FOCV_MatFileHeader));
+    mats.resize(header.count);
+
+    for (uint32_t i = 0; i < header.count; i++) {
+        const auto& entry = entries[i];
+
+        if (entry.dims < 0 || entry.dims > FOCV_MatFileMaxDims || entry.offset > size || entry.length > size - entry.offset) {
+            throw std::runtime_error("Corrupted Mat file: " + path);
+        }
+
+        if (entry.dims == 0 || entry.length == 0) {
+            mats[i] = cv::Mat();
+            continue;
+        }
+
+        if (entry.dims < 2 || entry.type != CV_MAT_TYPE(entry.type)) {
+            throw std::runtime_error("Corrupted Mat file: " + path);
+        }
+
+        // Checked before a header is created, so a corrupt entry can't reach past the file
+        uint64_t length = CV_ELEM_SIZE(entry.type);
+        for (int d = entry.dims - 1; d >= 0; d--) {
+            if (entry.sizes[d] <= 0 || entry.steps[d] != length || length > entry.length / entry.sizes[d]) {
+                throw std::runtime_error("Corrupted Mat file: " + path);
+            }
+            length *= entry.sizes[d];
+        }
+
+        if (length != entry.length) {
+            throw std::runtime_error("Corrupted Mat file: " + path);
+        }
+
+        // Header over the mapped pages, the data is not copied. Blocks are always
+        // written continuous, so the default steps match the stored ones.
+        mats[i] = mappedAllocator.wrap(mapping, entry.dims, entry.sizes, entry.type, const_cast<uchar*>(data + entry.offset), entry.length);
+    }
+
+    return static_cast<FOCV_MatFileKind>(header.kind);
+}
@@ -0,0 +1,72 @@
+//
+//  FOCV_MatFile.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_MatFile_hpp
+#define FOCV_MatFile_hpp
+
+#include <stdio.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "FOCV_FileIO.hpp"
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+// File layout (native endianness):
+//   header:  FOCV_MatFileHeader
+//   entries: header.count * FOCV_MatFileEntry
+//   data:    raw continuous Mat data, each block aligned to FOCV_MatFileAlignment
+// A point_vector is stored as a single CV_32SC2 Mat of n x 1.
+static const char FOCV_MatFileMagic[8] = { 'F', 'O', 'C', 'V', 'M', 'A', 'T', 0 };
+static const uint32_t FOCV_MatFileVersion = 1;
+static const int FOCV_MatFileMaxDims = 8;
+static const size_t FOCV_MatFileAlignment = 64;
+
+enum class FOCV_MatFileKind : uint32_t {
+    Mat = 1,
+    MatVector = 2,
+    PointVector = 3,
+    FeatureIndex = 4,
+};
+
+struct FOCV_MatFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct FOCV_MatFileEntry {
+    int32_t type;
+    int32_t dims;
+    int32_t sizes[FOCV_MatFileMaxDims];
+    uint64_t steps[FOCV_MatFileMaxDims];
+    uint64_t offset;
+    uint64_t length;
+};
+
+class FOCV_MatFile {
+public:
+    static void write(const std::string& path, FOCV_MatFileKind kind, const std::vector<cv::Mat>& mats);
+    // Fills `mats` with Mats pointing into a mapping of the file. The mapping
+    // is reference counted with the Mat data, so it stays alive as long as any
+    // Mat or ROI header on it does.
+    static FOCV_MatFileKind read(const std::string& path, std::vector<cv::Mat>& mats);
+};
+
+#endif /* FOCV_MatFile_hpp */
@@ -11,7 +11,19 @@
 #include "jsi/TypedArray.h"
 #include <opencv2/opencv.hpp>
 #include "ConvertImage.hpp"
-#include "jsi/TypedArray.h"
+#include "FOCV_Trace.hpp"
+#include "FOCV_PointTracker.hpp"
+#include "FOCV_BackgroundModel.hpp"
+#include "FOCV_TemplateSet.hpp"
+#include "FOCV_RemapTransform.hpp"
+#include "FOCV_FeatureIndex.hpp"
+#include "FOCV_DnnNet.hpp"
+#include "FOCV_ObjectTracker.hpp"
+#include "FOCV_FrameRing.hpp"
+#include "FOCV_FrameSignature.hpp"
+#include "FOCV_DirtyTracker.hpp"
+#include "FOCV_TiledExecutor.hpp"
+#include "FOCV_FileIO.hpp"
 
 using namespace mrousavy;
 
@@ -29,17 +41,90 @@ constexpr uint64_t hashString(const char* str, size_t length) {
   return hash;
 }
 
-jsi::Object FOCV_Object::create(jsi::Runtime& runtime, const jsi::Value* arguments) {
+static int depthForTypedArray(TypedArrayKind kind) {
+    switch(kind) {
+        case TypedArrayKind::Int8Array:
+            return CV_8S;
+        case TypedArrayKind::Uint8Array:
+        case TypedArrayKind::Uint8ClampedArray:
+            return CV_8U;
+        case TypedArrayKind::Int16Array:
+            return CV_16S;
+        case TypedArrayKind::Uint16Array:
+            return CV_16U;
+        case TypedArrayKind::Int32Array:
+            return CV_32S;
+        case TypedArrayKind::Float32Array:
+            return CV_32F;
+        case TypedArrayKind::Float64Array:
+            return CV_64F;
+        default:
+            return -1;
+    }
+}
+
+// Copies TypedArray content into an allocated Mat in one pass: a plain memcpy
+// when the element types match, a single convertTo otherwise. The TypedArray
+// must hold exactly total() * channels() elements.
+static void copyTypedArrayToMat(jsi::Runtime& runtime, const jsi::Object& object, cv::Mat& mat) {
+    TypedArrayBase array(runtime, object);
+    int depth = depthForTypedArray(array.getKind(runtime));
+
+    if(depth < 0) {
+        throw std::runtime_error("Unsupported TypedArray type for Mat data");
+    }
+
+    size_t elements = mat.total() * mat.channels();
+    if(array.byteLength(runtime) != elements * CV_ELEM_SIZE1(depth)) {
+        throw std::runtime_error("TypedArray length does not match the Mat size and channels");
+    }
+
+    uint8_t* data = array.getBuffer(runtime).data(runtime) + array.byteOffset(runtime);
+
+    if(depth == mat.depth()) {
+        memcpy(mat.data, data, elements * CV_ELEM_SIZE1(depth));
+    } else {
+        cv::Mat source(mat.dims, mat.size.p, CV_MAKETYPE(depth, mat.channels()), data);
+        source.convertTo(mat, mat.type());
+    }
+}
+
+jsi::Object FOCV_Object::create(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
     std::string id = "";
     std::string objectType = arguments[0].asString(runtime).utf8(runtime);
+    FOCV_TraceScope trace("allocation", objectType);
 
     switch(hashString(objectType.c_str(), objectType.size())) {
         case hashString("mat", 3): {
+            if(arguments[1].isObject()) {
+                auto sizesArray = arguments[1].asObject(runtime).asArray(runtime);
+                int type = arguments[2].asNumber();
+
+                std::vector<int> sizes(sizesArray.size(runtime));
+                for(size_t i = 0; i < sizes.size(); i++) {
+                    sizes[i] = sizesArray.getValueAtIndex(runtime, i).asNumber();
+                }
+
+                cv::Mat mat(static_cast<int>(sizes.size()), sizes.data(), type);
+
+                if(arguments[3].isObject()) {
+                    copyTypedArrayToMat(runtime, arguments[3].asObject(runtime), mat);
+                }
+
+                id = FOCV_Storage::save(mat);
+                break;
+            }
+
             int rows = arguments[1].asNumber();
             int cols = arguments[2].asNumber();
             int type = arguments[3].asNumber();
             
-            if(arguments[4].isObject()) {
+            if(arguments[4].isObject() && isTypedArray(runtime, arguments[4].asObject(runtime))) {
+                cv::Mat mat(rows, cols, type);
+                copyTypedArrayToMat(runtime, arguments[4].asObject(runtime), mat);
+
+                id = FOCV_Storage::save(mat);
+            } else if(arguments[4].isObject()) {
                 auto rawArray = arguments[4].asObject(runtime);
                 auto array = rawArray.asArray(runtime);
                 
@@ -47,13 +132,14 @@ jsi::Object FOCV_Object::create(jsi::Runtime& runtime, const jsi::Value* argumen
                 auto length = rawLength.asNumber();
                 
                 std::vector<float> vec;
+                vec.reserve(length);
                 
                 for(auto i = 0; i < length; i++) {
                     vec.push_back(array.getValueAtIndex(runtime, i).asNumber());
                 }
 
                 cv::Mat mat{vec, true};
-                mat = mat.reshape(1, rows);
+                mat = mat.reshape(CV_MAT_CN(type), rows);
                 mat.convertTo(mat, type);
                 
                 id = FOCV_Storage::save(mat);
@@ -133,13 +219,370 @@ jsi::Object FOCV_Object::create(jsi::Runtime& runtime, const jsi::Value* argumen
             cv::RotatedRect object(cv::Point(x,y), cv::Size(width, height), angle);
             id = FOCV_Storage::save(object);
         } break;
+        case hashString("point_tracker", 13): {
+            FOCV_PointTrackerOptions options;
+
+            if(count > 1 && arguments[1].isNumber()) {
+                options.maxPoints = arguments[1].asNumber();
+            }
+            if(count > 2 && arguments[2].isNumber()) {
+                options.minPoints = arguments[2].asNumber();
+            }
+            if(count > 3 && arguments[3].isNumber()) {
+                options.qualityLevel = arguments[3].asNumber();
+            }
+            if(count > 4 && arguments[4].isNumber()) {
+                options.minDistance = arguments[4].asNumber();
+            }
+
+            FOCV_PointTracker object(options);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("background_model", 16): {
+            FOCV_BackgroundModelOptions options;
+
+            if(count > 1 && arguments[1].isString()) {
+                options.method = arguments[1].asString(runtime).utf8(runtime);
+            }
+            if(count > 2 && arguments[2].isNumber()) {
+                options.scale = arguments[2].asNumber();
+            }
+            if(count > 3 && arguments[3].isNumber()) {
+                options.learningRate = arguments[3].asNumber();
+            }
+            if(count > 4 && arguments[4].isNumber()) {
+                options.threshold = arguments[4].asNumber();
+            }
+            if(count > 5 && arguments[5].isNumber()) {
+                options.minArea = arguments[5].asNumber();
+            }
+
+            FOCV_BackgroundModel object(options);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("template_set", 12): {
+            auto templates = FOCV_Storage::get<std::vector<cv::Mat>>(FOCV_JsiObject::id_from_wrap(runtime, arguments[1]));
+            double minScale = count > 2 && arguments[2].isNumber() ? arguments[2].asNumber() : 1.0;
+            double maxScale = count > 3 && arguments[3].isNumber() ? arguments[3].asNumber() : minScale;
+            int steps = count > 4 && arguments[4].isNumber() ? arguments[4].asNumber() : 1;
+            int method = count > 5 && arguments[5].isNumber() ? arguments[5].asNumber() : cv::TM_CCOEFF_NORMED;
+
+            FOCV_TemplateSet object(*templates, minScale, maxScale, steps, method);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("remap_transform", 15): {
+            double tolerance = count > 1 && arguments[1].isNumber() ? arguments[1].asNumber() : 1.0 / 32;
+
+            FOCV_RemapTransform object(tolerance);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("feature_index", 13): {
+            FOCV_FeatureIndexOptions options;
+
+            if(count > 1 && arguments[1].isNumber()) {
+                options.features = arguments[1].asNumber();
+            }
+            if(count > 2 && arguments[2].isNumber()) {
+                options.ratio = arguments[2].asNumber();
+            }
+            if(count > 3 && arguments[3].isNumber()) {
+                options.minInliers = arguments[3].asNumber();
+            }
+
+            FOCV_FeatureIndex object(options);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("object_tracker", 14): {
+            FOCV_ObjectTrackerOptions options;
+
+            if(count > 1 && arguments[1].isNumber()) {
+                options.maxAge = arguments[1].asNumber();
+            }
+            if(count > 2 && arguments[2].isNumber()) {
+                options.minHits = arguments[2].asNumber();
+            }
+            if(count > 3 && arguments[3].isNumber()) {
+                options.iouThreshold = arguments[3].asNumber();
+            }
+
+            FOCV_ObjectTracker object(options);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("frame_ring", 10): {
+            int capacity = arguments[1].asNumber();
+            int rows = arguments[2].asNumber();
+            int cols = arguments[3].asNumber();
+            int type = arguments[4].asNumber();
+
+            FOCV_FrameRing object(capacity, rows, cols, type);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("frame_signature", 15): {
+            FOCV_FrameSignatureOptions options;
+
+            if(count > 1 && arguments[1].isString()) {
+                options.method = arguments[1].asString(runtime).utf8(runtime);
+            }
+            if(count > 2 && arguments[2].isNumber()) {
+                options.size = arguments[2].asNumber();
+            }
+            if(count > 3 && arguments[3].isNumber()) {
+                options.threshold = arguments[3].asNumber();
+            }
+
+            FOCV_FrameSignature object(options);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
+        case hashString("dirty_tracker", 13): {
+            FOCV_DirtyTileOptions options;
+
+            if(count > 1 && arguments[1].isNumber()) {
+                options.tileWidth = arguments[1].asNumber();
+            }
+            if(count > 2 && arguments[2].isNumber()) {
+                options.tileHeight = arguments[2].asNumber();
+            }
+            if(count > 3 && arguments[3].isNumber()) {
+                options.threshold = arguments[3].asNumber();
+            }
+
+            FOCV_DirtyTracker object(options);
+            id = FOCV_Storage::save(object);
+            FOCV_Storage::persist(id);
+        } break;
     }
 
 
     return FOCV_JsiObject::wrap(runtime, objectType, id);
 }
 
-jsi::Object FOCV_Object::convertToJSI(jsi::Runtime& runtime, const jsi::Value* arguments) {
+// Reads { format, quality, compression, scale, output } where output is
+// 'base64' (default) or 'buffer'.
+static ImageEncodeOptions encodeOptions(jsi::Runtime& runtime, const jsi::Value& value, bool& asBuffer) {
+    ImageEncodeOptions options;
+    asBuffer = false;
+
+    if (!value.isObject()) {
+        return options;
+    }
+
+    auto object = value.asObject(runtime);
+
+    auto format = object.getProperty(runtime, "format");
+    if (format.isString()) {
+        options.format = format.asString(runtime).utf8(runtime);
+    }
+
+    auto quality = object.getProperty(runtime, "quality");
+    if (quality.isNumber()) {
+        options.quality = quality.asNumber();
+    }
+
+    auto compression = object.getProperty(runtime, "compression");
+    if (compression.isNumber()) {
+        options.compression = compression.asNumber();
+    }
+
+    auto scale = object.getProperty(runtime, "scale");
+    if (scale.isNumber()) {
+        options.scale = scale.asNumber();
+    }
+
+    auto output = object.getProperty(runtime, "output");
+    if (output.isString()) {
+        asBuffer = output.asString(runtime).utf8(runtime) == "buffer";
+    }
+
+    return options;
+}
+
+static jsi::Value encodeMat(jsi::Runtime& runtime, const cv::Mat& mat, const ImageEncodeOptions& options, bool asBuffer) {
+    if (!asBuffer) {
+        return jsi::String::createFromUtf8(runtime, ImageConverter::mat2str(mat, options));
+    }
+
+    const auto& bytes = ImageConverter::encode(mat, options);
+    auto arr = TypedArray<TypedArrayKind::Uint8Array>(runtime, bytes.size());
+    arr.updateUnsafe(runtime, const_cast<uint8_t*>(bytes.data()), bytes.size());
+
+    return jsi::Value(runtime, arr.getBuffer(runtime));
+}
+
+jsi::Value FOCV_Object::encode(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+    std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
+    bool asBuffer = false;
+    auto options = count > 1 ? encodeOptions(runtime, arguments[1], asBuffer) : ImageEncodeOptions();
+
+    return encodeMat(runtime, *FOCV_Storage::get<cv::Mat>(id), options, asBuffer);
+}
+
+// Reads { width, height, scale, mean, swapRB, crop }.
+static FOCV_DnnInputOptions dnnInputOptions(jsi::Runtime& runtime, const jsi::Object& object) {
+    FOCV_DnnInputOptions options;
+
+    auto width = object.getProperty(runtime, "width");
+    auto height = object.getProperty(runtime, "height");
+    if (width.isNumber() && height.isNumber()) {
+        options.size = cv::Size(width.asNumber(), height.asNumber());
+    }
+
+    auto scale = object.getProperty(runtime, "scale");
+    if (scale.isNumber()) {
+        options.scale = scale.asNumber();
+    }
+
+    auto mean = object.getProperty(runtime, "mean");
+    if (mean.isObject()) {
+        auto array = mean.asObject(runtime).asArray(runtime);
+        for (size_t i = 0; i < std::min<size_t>(4, array.size(runtime)); i++) {
+            options.mean[i] = array.getValueAtIndex(runtime, i).asNumber();
+        }
+    }
+
+    auto swapRB = object.getProperty(runtime, "swapRB");
+    if (swapRB.isBool()) {
+        options.swapRB = swapRB.getBool();
+    }
+
+    auto crop = object.getProperty(runtime, "crop");
+    if (crop.isBool()) {
+        options.crop = crop.getBool();
+    }
+
+    return options;
+}
+
+// arguments: net, input Mat, options. When options.outputs holds TypedArrays,
+// each output is also copied into the array at the same position.
+jsi::Object FOCV_Object::forward(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+    auto net = FOCV_Storage::get<FOCV_DnnNet>(FOCV_JsiObject::id_from_wrap(runtime, arguments[0]));
+    auto input = FOCV_Storage::get<cv::Mat>(FOCV_JsiObject::id_from_wrap(runtime, arguments[1]));
+
+    FOCV_DnnInputOptions options;
+    std::unique_ptr<jsi::Array> targets;
+
+    if (count > 2 && arguments[2].isObject()) {
+        auto object = arguments[2].asObject(runtime);
+        options = dnnInputOptions(runtime, object);
+
+        auto outputs = object.getProperty(runtime, "outputs");
+        if (outputs.isObject()) {
+            targets = std::make_unique<jsi::Array>(outputs.asObject(runtime).asArray(runtime));
+        }
+    }
+
+    // Headers only, the data stays in the net
+    std::vector<cv::Mat> outputs = net->forward(*input, options);
+
+    if (targets) {
+        for (size_t i = 0; i < std::min(outputs.size(), targets->size(runtime)); i++) {
+            TypedArrayBase target(runtime, targets->getValueAtIndex(runtime, i).asObject(runtime));
+            size_t length = outputs[i].total() * outputs[i].elemSize();
+
+            if (target.byteLength(runtime) != length) {
+                throw std::runtime_error("Output " + std::to_string(i) + " needs " + std::to_string(length) + " bytes");
+            }
+
+            auto data = target.getBuffer(runtime).data(runtime) + target.byteOffset(runtime);
+            std::memcpy(data, outputs[i].data, length);
+        }
+    }
+
+    auto names = jsi::Array(runtime, net->names().size());
+    for (size_t i = 0; i < net->names().size(); i++) {
+        names.setValueAtIndex(runtime, i, jsi::String::createFromUtf8(runtime, net->names()[i]));
+    }
+
+    jsi::Object value(runtime);
+    value.setProperty(runtime, "outputs", FOCV_JsiObject::wrap(runtime, "mat_vector", FOCV_Storage::save(outputs)));
+    value.setProperty(runtime, "names", names);
+
+    return value;
+}
+
+// Reads { name, ksize, sigma, op, shape, iterations, thresh, maxval, method,
+// type, blockSize, C, code } with the parameter names of the OpenCV functions.
+static FOCV_TiledOp tiledOp(jsi::Runtime& runtime, const jsi::Object& object) {
+    auto op = FOCV_TiledOp::parse(object.getProperty(runtime, "name").asString(runtime).utf8(runtime));
+
+    auto number = [&](const char* name, auto& field) {
+        auto value = object.getProperty(runtime, name);
+        if (value.isNumber()) {
+            field = value.asNumber();
+        }
+    };
+
+    number("ksize", op.ksize);
+    number("blockSize", op.ksize);
+    number("sigma", op.sigma);
+    number("shape", op.shape);
+    number("iterations", op.iterations);
+    number("thresh", op.thresh);
+    number("maxval", op.maxValue);
+    number("maxValue", op.maxValue);
+    number("method", op.method);
+    number("C", op.c);
+    number("type", op.type);
+    number("op", op.type);
+    number("code", op.type);
+
+    return op;
+}
+
+// arguments: source Mat or image path, array of operations, options
+jsi::Object FOCV_Object::processTiled(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+    FOCV_TiledOptions options;
+    int flags = cv::IMREAD_UNCHANGED;
+
+    if (count > 2 && arguments[2].isObject()) {
+        auto object = arguments[2].asObject(runtime);
+
+        auto tileSize = object.getProperty(runtime, "tileSize");
+        if (tileSize.isNumber()) {
+            options.tileSize = tileSize.asNumber();
+        }
+
+        auto cacheSize = object.getProperty(runtime, "cacheSize");
+        if (cacheSize.isNumber()) {
+            options.cacheSize = cacheSize.asNumber();
+        }
+
+        auto imreadFlags = object.getProperty(runtime, "flags");
+        if (imreadFlags.isNumber()) {
+            flags = imreadFlags.asNumber();
+        }
+    }
+
+    auto array = arguments[1].asObject(runtime).asArray(runtime);
+    std::vector<FOCV_TiledOp> ops;
+
+    for (size_t i = 0; i < array.size(runtime); i++) {
+        ops.push_back(tiledOp(runtime, array.getValueAtIndex(runtime, i).asObject(runtime)));
+    }
+
+    cv::Mat dst;
+
+    if (arguments[0].isString()) {
+        // Decoded for this call only, it never enters the storage
+        cv::Mat src = FOCV_FileIO::read(arguments[0].asString(runtime).utf8(runtime), flags);
+        dst = FOCV_TiledExecutor::run(src, ops, options);
+    } else {
+        auto src = FOCV_Storage::get<cv::Mat>(FOCV_JsiObject::id_from_wrap(runtime, arguments[0]));
+        dst = FOCV_TiledExecutor::run(*src, ops, options);
+    }
+
+    return FOCV_JsiObject::wrap(runtime, "mat", FOCV_Storage::save(dst));
+}
+
+jsi::Object FOCV_Object::convertToJSI(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
     jsi::Object value(runtime);
     std::string objectType = FOCV_JsiObject::type_from_wrap(runtime, arguments[0]);
     std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
@@ -147,12 +590,22 @@ jsi::Object FOCV_Object::convertToJSI(jsi::Runtime& runtime, const jsi::Value* a
     switch(hashString(objectType.c_str(), objectType.size())) {
         case hashString("mat", 3): {
             auto mat = *FOCV_Storage::get<cv::Mat>(id);
-            mat.convertTo(mat, CV_8U);
+            bool asBuffer = false;
+            auto options = count > 1 ? encodeOptions(runtime, arguments[1], asBuffer) : ImageEncodeOptions();
+
+            // Dimensions of the encoded image, computed like cv::resize does for a scale factor
+            int cols = mat.cols;
+            int rows = mat.rows;
+            if (options.scale > 0 && options.scale != 1.0) {
+                cols = saturate_cast<int>(mat.cols * options.scale);
+                rows = saturate_cast<int>(mat.rows * options.scale);
+            }
 
-            value.setProperty(runtime, "base64", jsi::String::createFromUtf8(runtime, ImageConverter::mat2str(mat)));
-            value.setProperty(runtime, "size", jsi::Value(mat.size));
-            value.setProperty(runtime, "cols", jsi::Value(mat.cols));
-            value.setProperty(runtime, "rows", jsi::Value(mat.rows));
+            value.setProperty(runtime, asBuffer ? "buffer" : "base64", encodeMat(runtime, mat, options, asBuffer));
+            // Pixel count of the encoded image, like cols and rows
+            value.setProperty(runtime, "size", jsi::Value(static_cast<double>(cols) * rows));
+            value.setProperty(runtime, "cols", jsi::Value(cols));
+            value.setProperty(runtime, "rows", jsi::Value(rows));
         } break;
         case hashString("mat_vector", 10): {
             auto mats = *FOCV_Storage::get<std::vector<cv::Mat>>(id);
@@ -251,6 +704,86 @@ jsi::Object FOCV_Object::convertToJSI(jsi::Runtime& runtime, const jsi::Value* a
     return value;
 }
 
+// Packs a whole vector into one typed array instead of one JS object per item.
+// Points are stored as x,y pairs and rects as x,y,width,height. Mats are
+// concatenated, with `offsets[i]` giving the index of the first value of mat i
+// and `offsets[count]` the total length.
+jsi::Object FOCV_Object::convertToBuffer(jsi::Runtime& runtime, const jsi::Value* arguments) {
+    jsi::Object value(runtime);
+    std::string objectType = FOCV_JsiObject::type_from_wrap(runtime, arguments[0]);
+    std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
+
+    switch(hashString(objectType.c_str(), objectType.size())) {
+        case hashString("point_vector", 12): {
+            auto points = FOCV_Storage::get<std::vector<cv::Point>>(id);
+            auto buffer = TypedArray<TypedArrayKind::Int32Array>(runtime, points->size() * 2);
+
+            buffer.updateUnsafe(runtime, reinterpret_cast<int32_t*>(points->data()), points->size() * sizeof(cv::Point));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(points->size())));
+            value.setProperty(runtime, "buffer", buffer);
+        } break;
+        case hashString("rect_vector", 11): {
+            auto rects = FOCV_Storage::get<std::vector<cv::Rect>>(id);
+            auto buffer = TypedArray<TypedArrayKind::Int32Array>(runtime, rects->size() * 4);
+
+            buffer.updateUnsafe(runtime, reinterpret_cast<int32_t*>(rects->data()), rects->size() * sizeof(cv::Rect));
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(rects->size())));
+            value.setProperty(runtime, "buffer", buffer);
+        } break;
+        case hashString("mat_vector", 10): {
+            auto mats = FOCV_Storage::get<std::vector<cv::Mat>>(id);
+            auto offsets = TypedArray<TypedArrayKind::Int32Array>(runtime, mats->size() + 1);
+            auto offsetsData = reinterpret_cast<int32_t*>(offsets.data(runtime));
+
+            // Contours from findContours are CV_32S, anything else is exported as float.
+            bool integer = true;
+            size_t length = 0;
+
+            for (size_t i = 0; i < mats->size(); i++) {
+                const auto& mat = mats->at(i);
+
+                offsetsData[i] = static_cast<int32_t>(length);
+                length += mat.total() * mat.channels();
+                integer = integer && mat.depth() == CV_32S;
+            }
+            offsetsData[mats->size()] = static_cast<int32_t>(length);
+
+            int depth = integer ? CV_32S : CV_32F;
+            uint8_t* data;
+
+            if (integer) {
+                auto buffer = TypedArray<TypedArrayKind::Int32Array>(runtime, length);
+                data = buffer.data(runtime);
+                value.setProperty(runtime, "buffer", buffer);
+            } else {
+                auto buffer = TypedArray<TypedArrayKind::Float32Array>(runtime, length);
+                data = buffer.data(runtime);
+                value.setProperty(runtime, "buffer", buffer);
+            }
+
+            for (size_t i = 0; i < mats->size(); i++) {
+                const auto& mat = mats->at(i);
+
+                if (mat.empty()) {
+                    continue;
+                }
+
+                cv::Mat target(mat.dims, mat.size.p, CV_MAKETYPE(depth, mat.channels()), data + offsetsData[i] * sizeof(int32_t));
+                mat.convertTo(target, target.type());
+            }
+
+            value.setProperty(runtime, "count", jsi::Value(static_cast<int>(mats->size())));
+            value.setProperty(runtime, "offsets", offsets);
+        } break;
+        default:
+            throw std::runtime_error("vectorToBuffer supports point_vector, rect_vector and mat_vector");
+    }
+
+    return value;
+}
+
 jsi::Object FOCV_Object::copyObjectFromVector(jsi::Runtime& runtime, const jsi::Value* arguments) {
     std::string createdId;
 
@@ -261,20 +794,20 @@ jsi::Object FOCV_Object::copyObjectFromVector(jsi::Runtime& runtime, const jsi::
 
     switch(hashString(objectType.c_str(), objectType.size())) {
         case hashString("mat_vector", 10): {
-            auto array = *FOCV_Storage::get<std::vector<cv::Mat>>(vectorId);
-            cv::Mat mat = array.at(index);
+            auto array = FOCV_Storage::get<std::vector<cv::Mat>>(vectorId);
+            cv::Mat mat = array->at(index);
             createdId = FOCV_Storage::save(mat);
             return FOCV_JsiObject::wrap(runtime, "mat", createdId);
         } break;
         case hashString("rect_vector", 11): {
-            auto array = *FOCV_Storage::get<std::vector<cv::Rect>>(vectorId);
-            cv::Rect rect = array.at(index);
+            auto array = FOCV_Storage::get<std::vector<cv::Rect>>(vectorId);
+            cv::Rect rect = array->at(index);
             createdId = FOCV_Storage::save(rect);
             return FOCV_JsiObject::wrap(runtime, "rect", createdId);
         } break;
         case hashString("point_vector", 12): {
-            auto array = *FOCV_Storage::get<std::vector<cv::Point>>(vectorId);
-            cv::Point point = array.at(index);
+            auto array = FOCV_Storage::get<std::vector<cv::Point>>(vectorId);
+            cv::Point point = array->at(index);
             createdId = FOCV_Storage::save(point);
             return FOCV_JsiObject::wrap(runtime, "point", createdId);
         } break;
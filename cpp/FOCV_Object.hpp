@@ -30,8 +30,12 @@ using namespace facebook;
 
 class FOCV_Object {
 public:
-    static jsi::Object create(jsi::Runtime& runtime, const jsi::Value* arguments);
-    static jsi::Object convertToJSI(jsi::Runtime& runtime, const jsi::Value* arguments);
+    static jsi::Object create(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+    static jsi::Object convertToJSI(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+    static jsi::Value encode(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+    static jsi::Object forward(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+    static jsi::Object processTiled(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+    static jsi::Object convertToBuffer(jsi::Runtime& runtime, const jsi::Value* arguments);
     static jsi::Object copyObjectFromVector(jsi::Runtime& runtime, const jsi::Value* arguments);
 };
 
@@ -0,0 +1,151 @@
+//
+//  FOCV_ObjectTracker.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_ObjectTracker.hpp"
+#include <algorithm>
+
+// State: center x, center y, width, height and their velocities.
+static const int FOCV_TrackState = 8;
+static const int FOCV_TrackMeasurement = 4;
+
+static cv::Mat measurement(const cv::Rect2f& box) {
+    return (cv::Mat_<float>(FOCV_TrackMeasurement, 1) << box.x + box.width / 2, box.y + box.height / 2, box.width, box.height);
+}
+
+static cv::Rect2f boxFromState(const cv::Mat& state) {
+    float width = std::max(1.0f, state.at<float>(2));
+    float height = std::max(1.0f, state.at<float>(3));
+
+    return cv::Rect2f(state.at<float>(0) - width / 2, state.at<float>(1) - height / 2, width, height);
+}
+
+static float intersectionOverUnion(const cv::Rect2f& a, const cv::Rect2f& b) {
+    float intersection = (a & b).area();
+    float area = a.area() + b.area() - intersection;
+
+    return area > 0 ? intersection / area : 0;
+}
+
+FOCV_ObjectTracker::FOCV_ObjectTracker(const FOCV_ObjectTrackerOptions& options) : options(options) {}
+
+FOCV_ObjectTracker::Track FOCV_ObjectTracker::create(const cv::Rect2f& box, float score) {
+    Track track;
+    track.filter.init(FOCV_TrackState, FOCV_TrackMeasurement, 0, CV_32F);
+
+    cv::setIdentity(track.filter.transitionMatrix);
+    for (int i = 0; i < FOCV_TrackMeasurement; i++) {
+        track.filter.transitionMatrix.at<float>(i, i + FOCV_TrackMeasurement) = 1;
+    }
+
+    cv::setIdentity(track.filter.measurementMatrix);
+
+    // Noise levels of SORT: size measurements are less reliable than the
+    // center, and the velocities start out unknown.
+    track.filter.processNoiseCov = cv::Mat::diag((cv::Mat_<float>(FOCV_TrackState, 1) << 1, 1, 1, 1, 0.01f, 0.01f, 0.0001f, 0.0001f));
+    track.filter.measurementNoiseCov = cv::Mat::diag((cv::Mat_<float>(FOCV_TrackMeasurement, 1) << 1, 1, 10, 10));
+    track.filter.errorCovPost = cv::Mat::diag((cv::Mat_<float>(FOCV_TrackState, 1) << 10, 10, 10, 10, 10000, 10000, 10000, 10000));
+
+    track.filter.statePost = cv::Mat::zeros(FOCV_TrackState, 1, CV_32F);
+    measurement(box).copyTo(track.filter.statePost.rowRange(0, FOCV_TrackMeasurement));
+
+    track.id = nextId++;
+    track.hits = 1;
+    track.missed = 0;
+    track.predicted = 0;
+    track.score = score;
+    track.box = box;
+
+    return track;
+}
+
+void FOCV_ObjectTracker::update(const std::vector<cv::Rect>* detections, const std::vector<float>& scores) {
+    bool detected = detections != nullptr;
+
+    for (auto& track : tracks) {
+        track.box = boxFromState(track.filter.predict());
+        track.predicted++;
+
+        if (detected) {
+            track.missed++;
+        }
+    }
+
+    if (detections != nullptr && !detections->empty()) {
+        // Greedy association: best IoU pairs first
+        struct Pair {
+            float iou;
+            int track;
+            int detection;
+        };
+
+        std::vector<Pair> pairs;
+        for (int t = 0; t < static_cast<int>(tracks.size()); t++) {
+            for (int d = 0; d < static_cast<int>(detections->size()); d++) {
+                float iou = intersectionOverUnion(tracks[t].box, cv::Rect2f((*detections)[d]));
+                if (iou >= options.iouThreshold) {
+                    pairs.push_back({ iou, t, d });
+                }
+            }
+        }
+
+        std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) { return a.iou > b.iou; });
+
+        std::vector<bool> trackUsed(tracks.size(), false);
+        std::vector<bool> detectionUsed(detections->size(), false);
+
+        for (const auto& pair : pairs) {
+            if (trackUsed[pair.track] || detectionUsed[pair.detection]) {
+                continue;
+            }
+
+            trackUsed[pair.track] = true;
+            detectionUsed[pair.detection] = true;
+
+            auto& track = tracks[pair.track];
+            track.box = boxFromState(track.filter.correct(measurement(cv::Rect2f((*detections)[pair.detection]))));
+            track.hits++;
+            track.missed = 0;
+            track.predicted = 0;
+            track.score = pair.detection < static_cast<int>(scores.size()) ? scores[pair.detection] : 1.0f;
+        }
+
+        for (size_t d = 0; d < detections->size(); d++) {
+            if (!detectionUsed[d]) {
+                tracks.push_back(create(cv::Rect2f((*detections)[d]), d < scores.size() ? scores[d] : 1.0f));
+            }
+        }
+    }
+
+    // Tentative tracks are dropped as soon as a detection frame misses them;
+    // frames without detections never remove a track.
+    tracks.erase(std::remove_if(tracks.begin(), tracks.end(), [&](const Track& track) {
+        return track.missed > options.maxAge || (detected && track.missed > 0 && track.hits < options.minHits);
+    }), tracks.end());
+}
+
+void FOCV_ObjectTracker::objects(std::vector<int32_t>& ids, std::vector<FOCV_TrackedObject>& objects) const {
+    ids.clear();
+    objects.clear();
+
+    for (const auto& track : tracks) {
+        if (track.hits < options.minHits) {
+            continue;
+        }
+
+        ids.push_back(track.id);
+        objects.push_back({
+            track.box.x,
+            track.box.y,
+            track.box.width,
+            track.box.height,
+            track.score,
+            static_cast<float>(track.predicted),
+        });
+    }
+}
+
+void FOCV_ObjectTracker::reset() {
+    tracks.clear();
+}
@@ -0,0 +1,79 @@
+//
+//  FOCV_ObjectTracker.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_ObjectTracker_hpp
+#define FOCV_ObjectTracker_hpp
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+struct FOCV_ObjectTrackerOptions {
+    // Detection frames a track is kept, predicted, without a matching
+    // detection. Frames without detections don't count, so detection can run
+    // every Nth frame regardless of N.
+    int maxAge = 5;
+    // Detections matched in a row before a track is reported
+    int minHits = 3;
+    double iouThreshold = 0.3;
+};
+
+struct FOCV_TrackedObject {
+    float x;
+    float y;
+    float width;
+    float height;
+    float score;
+    // Frames since the last matching detection; 0 when updated this frame
+    float missed;
+};
+
+// SORT-style tracker: every track is a constant velocity Kalman filter over
+// the box center and size. Detections are associated greedily by IoU with the
+// predicted boxes; unmatched detections start new tracks.
+class FOCV_ObjectTracker {
+private:
+    struct Track {
+        cv::KalmanFilter filter;
+        int32_t id;
+        int hits;
+        // Detection frames without a match, for maxAge
+        int missed;
+        // Frames of any kind since the last match, reported to JS
+        int predicted;
+        float score;
+        cv::Rect2f box;
+    };
+
+    FOCV_ObjectTrackerOptions options;
+    std::vector<Track> tracks;
+    int32_t nextId = 0;
+
+    Track create(const cv::Rect2f& box, float score);
+
+public:
+    FOCV_ObjectTracker(const FOCV_ObjectTrackerOptions& options);
+
+    // Without detections, the tracks are only predicted.
+    void update(const std::vector<cv::Rect>* detections, const std::vector<float>& scores);
+    // Confirmed tracks only
+    void objects(std::vector<int32_t>& ids, std::vector<FOCV_TrackedObject>& objects) const;
+    void reset();
+};
+
+#endif /* FOCV_ObjectTracker_hpp */
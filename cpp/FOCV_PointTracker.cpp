@@ -0,0 +1,77 @@
+//
+//  FOCV_PointTracker.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_PointTracker.hpp"
+
+FOCV_PointTracker::FOCV_PointTracker(const FOCV_PointTrackerOptions& options) : options(options) {}
+
+void FOCV_PointTracker::reset() {
+    previousPyramid.clear();
+    points.clear();
+    ids.clear();
+}
+
+void FOCV_PointTracker::track(const cv::Mat& frame) {
+    if (frame.channels() == 1) {
+        gray = frame;
+    } else {
+        cv::cvtColor(frame, gray, frame.channels() == 4 ? cv::COLOR_RGBA2GRAY : cv::COLOR_RGB2GRAY);
+    }
+
+    // A different frame size invalidates the previous pyramid
+    if (!previousPyramid.empty() && previousPyramid[0].size() != gray.size()) {
+        reset();
+    }
+
+    // Never reuse the input as level 0, the caller may overwrite the frame
+    cv::buildOpticalFlowPyramid(gray, pyramid, options.winSize, options.maxLevel, true, cv::BORDER_REFLECT_101, cv::BORDER_CONSTANT, false);
+
+    if (!previousPyramid.empty() && !points.empty()) {
+        cv::calcOpticalFlowPyrLK(previousPyramid, pyramid, points, next, status, error, options.winSize, options.maxLevel);
+
+        cv::Rect bounds({}, gray.size());
+        size_t kept = 0;
+
+        for (size_t i = 0; i < points.size(); i++) {
+            if (status[i] && bounds.contains(next[i])) {
+                points[kept] = next[i];
+                ids[kept] = ids[i];
+                kept++;
+            }
+        }
+
+        points.resize(kept);
+        ids.resize(kept);
+    }
+
+    if (static_cast<int>(points.size()) < options.minPoints) {
+        seed();
+    }
+
+    // The current pyramid becomes the previous one, buffers are reused
+    std::swap(previousPyramid, pyramid);
+}
+
+void FOCV_PointTracker::seed() {
+    int missing = options.maxPoints - static_cast<int>(points.size());
+
+    if (missing <= 0) {
+        return;
+    }
+
+    // Only look for corners away from the points that are still tracked
+    mask.create(gray.size(), CV_8UC1);
+    mask.setTo(255);
+    for (const auto& point : points) {
+        cv::circle(mask, point, static_cast<int>(options.minDistance), cv::Scalar(0), cv::FILLED);
+    }
+
+    cv::goodFeaturesToTrack(gray, corners, missing, options.qualityLevel, options.minDistance, mask);
+
+    for (const auto& corner : corners) {
+        points.push_back(corner);
+        ids.push_back(nextId++);
+    }
+}
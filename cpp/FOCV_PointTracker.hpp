@@ -0,0 +1,64 @@
+//
+//  FOCV_PointTracker.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_PointTracker_hpp
+#define FOCV_PointTracker_hpp
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+struct FOCV_PointTrackerOptions {
+    int maxPoints = 200;
+    // New corners are detected when fewer points than this are left
+    int minPoints = 50;
+    double qualityLevel = 0.01;
+    double minDistance = 10;
+    cv::Size winSize = cv::Size(21, 21);
+    int maxLevel = 3;
+};
+
+// Tracks a set of points across frames with pyramidal Lucas-Kanade. The
+// pyramid of the previous frame is kept, so each frame is only processed once.
+// Every point keeps its id for as long as it is tracked.
+class FOCV_PointTracker {
+private:
+    FOCV_PointTrackerOptions options;
+    std::vector<cv::Mat> previousPyramid;
+    std::vector<cv::Mat> pyramid;
+    cv::Mat gray;
+    cv::Mat mask;
+    std::vector<cv::Point2f> next;
+    std::vector<uchar> status;
+    std::vector<float> error;
+    std::vector<cv::Point2f> corners;
+    int32_t nextId = 0;
+
+    void seed();
+
+public:
+    std::vector<cv::Point2f> points;
+    std::vector<int32_t> ids;
+
+    FOCV_PointTracker(const FOCV_PointTrackerOptions& options);
+
+    void track(const cv::Mat& frame);
+    void reset();
+};
+
+#endif /* FOCV_PointTracker_hpp */
@@ -0,0 +1,337 @@
+//
+//  FOCV_Recorder.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_Recorder.hpp"
+#include "FOCV_Storage.hpp"
+#include "FOCV_JsiObject.hpp"
+#include "jsi/TypedArray.h"
+
+using namespace mrousavy;
+
+std::mutex FOCV_Recorder::mutex;
+std::ofstream FOCV_Recorder::file;
+std::unordered_map<std::string, uint32_t> FOCV_Recorder::handles;
+std::atomic<bool> FOCV_Recorder::recording(false);
+bool FOCV_Recorder::hashBuffers = false;
+
+// General idea and this function for hashing is from
+// https://mrousavy.com/blog/Hashing-String-Ifs
+constexpr uint64_t hashString(const char* str, size_t length) {
+  uint64_t hash = 14695981039346656037ull;
+  const uint64_t fnv_prime = 1099511628211ull;
+
+  for (size_t i = 0; i < length; ++i) {
+      hash ^= static_cast<uint64_t>(str[i]);
+      hash *= fnv_prime;
+  }
+
+  return hash;
+}
+
+void FOCV_RecordWriter::writeString(const std::string& value) {
+    write<uint32_t>(value.size());
+    writeBytes(value.data(), value.size());
+}
+
+void FOCV_RecordWriter::writeBytes(const void* data, size_t length) {
+    auto start = reinterpret_cast<const uint8_t*>(data);
+    bytes.insert(bytes.end(), start, start + length);
+}
+
+bool FOCV_Recorder::start(const std::string& path, bool hashBuffers) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (file.is_open()) {
+        file.close();
+    }
+
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        recording = false;
+        return false;
+    }
+
+    FOCV_Recorder::hashBuffers = hashBuffers;
+    handles.clear();
+
+    FOCV_RecordWriter header;
+    header.writeBytes(FOCV_RecordMagic, sizeof(FOCV_RecordMagic));
+    header.write<uint8_t>(FOCV_RecordVersion);
+    header.write<uint8_t>(hashBuffers ? FOCV_RecordHashBuffers : 0);
+    file.write(reinterpret_cast<const char*>(header.bytes.data()), header.bytes.size());
+
+    recording = true;
+    return true;
+}
+
+void FOCV_Recorder::stop() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    recording = false;
+
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool FOCV_Recorder::isRecording() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+uint64_t FOCV_Recorder::hash(const uint8_t* data, size_t length) {
+    return hashString(reinterpret_cast<const char*>(data), length);
+}
+
+uint32_t FOCV_Recorder::registerHandle(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Results written in place keep their handle, so handle numbers stay unique
+    auto existing = handles.find(id);
+    if (existing != handles.end()) {
+        return existing->second;
+    }
+
+    uint32_t handle = handles.size();
+    handles.emplace(id, handle);
+
+    return handle;
+}
+
+uint32_t FOCV_Recorder::handleFor(const std::string& id, const std::string& type) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto existing = handles.find(id);
+    if (existing != handles.end()) {
+        return existing->second;
+    }
+
+    uint32_t handle = handles.size();
+    handles.insert_or_assign(id, handle);
+
+    // Object created before recording started, so its content goes into the trace.
+    FOCV_RecordWriter payload;
+
+    try {
+        writeSnapshot(id, type, payload);
+    } catch (...) {
+        return handle;
+    }
+
+    FOCV_RecordWriter snapshot;
+    snapshot.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordKind::Snapshot));
+    snapshot.write<uint32_t>(handle);
+    snapshot.writeString(type);
+    snapshot.write<uint32_t>(payload.bytes.size());
+    snapshot.writeBytes(payload.bytes.data(), payload.bytes.size());
+
+    file.write(reinterpret_cast<const char*>(snapshot.bytes.data()), snapshot.bytes.size());
+    return handle;
+}
+
+void FOCV_Recorder::writeMat(const cv::Mat& mat, bool withData, FOCV_RecordWriter& writer) {
+    cv::Mat continuous = mat.isContinuous() ? mat : mat.clone();
+    size_t length = continuous.total() * continuous.elemSize();
+
+    writer.write<int32_t>(continuous.rows);
+    writer.write<int32_t>(continuous.cols);
+    writer.write<int32_t>(continuous.type());
+    writer.write<uint8_t>(withData ? 1 : 0);
+    writer.write<uint32_t>(length);
+
+    if (withData) {
+        writer.writeBytes(continuous.data, length);
+    } else {
+        writer.write<uint64_t>(hash(continuous.data, length));
+    }
+}
+
+void FOCV_Recorder::writeSnapshot(const std::string& id, const std::string& type, FOCV_RecordWriter& writer) {
+    switch(hashString(type.c_str(), type.size())) {
+        case hashString("mat", 3): {
+            writeMat(*FOCV_Storage::get<cv::Mat>(id), !hashBuffers, writer);
+        } break;
+        case hashString("mat_vector", 10): {
+            auto mats = FOCV_Storage::get<std::vector<cv::Mat>>(id);
+
+            writer.write<uint32_t>(mats->size());
+            for (auto& mat : *mats) {
+                writeMat(mat, !hashBuffers, writer);
+            }
+        } break;
+        case hashString("point", 5): {
+            auto point = FOCV_Storage::get<cv::Point>(id);
+
+            writer.write<int32_t>(point->x);
+            writer.write<int32_t>(point->y);
+        } break;
+        case hashString("point_vector", 12): {
+            auto points = FOCV_Storage::get<std::vector<cv::Point>>(id);
+
+            writer.write<uint32_t>(points->size());
+            writer.writeBytes(points->data(), points->size() * sizeof(cv::Point));
+        } break;
+        case hashString("rect", 4): {
+            auto rect = FOCV_Storage::get<cv::Rect>(id);
+
+            writer.writeBytes(&(*rect), sizeof(cv::Rect));
+        } break;
+        case hashString("rect_vector", 11): {
+            auto rects = FOCV_Storage::get<std::vector<cv::Rect>>(id);
+
+            writer.write<uint32_t>(rects->size());
+            writer.writeBytes(rects->data(), rects->size() * sizeof(cv::Rect));
+        } break;
+        case hashString("size", 4): {
+            auto size = FOCV_Storage::get<cv::Size>(id);
+
+            writer.write<int32_t>(size->width);
+            writer.write<int32_t>(size->height);
+        } break;
+        case hashString("vec3b", 5): {
+            auto vec = FOCV_Storage::get<cv::Vec3b>(id);
+
+            writer.writeBytes(vec->val, 3);
+        } break;
+        case hashString("scalar", 6): {
+            auto scalar = FOCV_Storage::get<cv::Scalar>(id);
+
+            writer.writeBytes(scalar->val, 4 * sizeof(double));
+        } break;
+        case hashString("rotated_rect", 12): {
+            auto rect = FOCV_Storage::get<cv::RotatedRect>(id);
+
+            writer.write<float>(rect->center.x);
+            writer.write<float>(rect->center.y);
+            writer.write<float>(rect->size.width);
+            writer.write<float>(rect->size.height);
+            writer.write<float>(rect->angle);
+        } break;
+        default:
+            throw std::runtime_error("Objects of type " + type + " have no snapshot");
+    }
+}
+
+void FOCV_Recorder::writeBuffer(const uint8_t* data, size_t length, uint8_t kind, FOCV_RecordWriter& writer) {
+    if (hashBuffers) {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::BufferHash));
+        writer.write<uint8_t>(kind);
+        writer.write<uint32_t>(length);
+        writer.write<uint64_t>(hash(data, length));
+    } else {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Buffer));
+        writer.write<uint8_t>(kind);
+        writer.write<uint32_t>(length);
+        writer.writeBytes(data, length);
+    }
+}
+
+void FOCV_Recorder::writeValue(jsi::Runtime& runtime, const jsi::Value& value, FOCV_RecordWriter& writer) {
+    if (value.isUndefined()) {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Undefined));
+    } else if (value.isNull()) {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Null));
+    } else if (value.isBool()) {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Bool));
+        writer.write<uint8_t>(value.getBool() ? 1 : 0);
+    } else if (value.isNumber()) {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Number));
+        writer.write<double>(value.getNumber());
+    } else if (value.isString()) {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::String));
+        writer.writeString(value.getString(runtime).utf8(runtime));
+    } else if (value.isObject()) {
+        auto object = value.getObject(runtime);
+
+        if (object.isArrayBuffer(runtime)) {
+            auto buffer = object.getArrayBuffer(runtime);
+            writeBuffer(buffer.data(runtime), buffer.size(runtime), FOCV_ArrayBufferKind, writer);
+        } else if (object.isArray(runtime)) {
+            auto array = object.getArray(runtime);
+            size_t length = array.size(runtime);
+
+            writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Array));
+            writer.write<uint32_t>(length);
+            for (size_t i = 0; i < length; i++) {
+                writeValue(runtime, array.getValueAtIndex(runtime, i), writer);
+            }
+        } else if (isTypedArray(runtime, object)) {
+            TypedArrayBase typedArray(runtime, object);
+            auto data = typedArray.getBuffer(runtime).data(runtime) + typedArray.byteOffset(runtime);
+            auto kind = static_cast<uint8_t>(typedArray.getKind(runtime));
+
+            writeBuffer(data, typedArray.byteLength(runtime), kind, writer);
+        } else if (object.hasProperty(runtime, "id") && object.hasProperty(runtime, "type")) {
+            std::string id = FOCV_JsiObject::id_from_wrap(runtime, value);
+            std::string type = FOCV_JsiObject::type_from_wrap(runtime, value);
+
+            writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Handle));
+            writer.writeString(type);
+            writer.write<uint32_t>(handleFor(id, type));
+        } else {
+            auto names = object.getPropertyNames(runtime);
+            size_t length = names.size(runtime);
+
+            writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Object));
+            writer.write<uint32_t>(length);
+            for (size_t i = 0; i < length; i++) {
+                auto name = names.getValueAtIndex(runtime, i).asString(runtime).utf8(runtime);
+
+                writer.writeString(name);
+                writeValue(runtime, object.getProperty(runtime, name.c_str()), writer);
+            }
+        }
+    } else {
+        writer.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordTag::Undefined));
+    }
+}
+
+FOCV_Recording::FOCV_Recording(jsi::Runtime& runtime, const char* function, const jsi::Value* arguments, size_t count) {
+    this->active = FOCV_Recorder::isRecording();
+
+    if (!this->active) {
+        return;
+    }
+
+    call.write<uint8_t>(static_cast<uint8_t>(FOCV_RecordKind::Call));
+    call.writeString(function);
+    call.write<uint32_t>(count);
+
+    for (size_t i = 0; i < count; i++) {
+        FOCV_Recorder::writeValue(runtime, arguments[i], call);
+    }
+
+    this->start = std::chrono::steady_clock::now();
+}
+
+void FOCV_Recording::finish(jsi::Runtime& runtime, const jsi::Value& result) {
+    if (!this->active) {
+        return;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count();
+    uint32_t handle = FOCV_NoHandle;
+
+    if (result.isObject()) {
+        auto object = result.getObject(runtime);
+
+        if (object.hasProperty(runtime, "id") && object.hasProperty(runtime, "type")) {
+            handle = FOCV_Recorder::registerHandle(FOCV_JsiObject::id_from_wrap(runtime, result));
+        }
+    }
+
+    call.write<uint32_t>(handle);
+    call.write<uint64_t>(duration);
+
+    std::lock_guard<std::mutex> lock(FOCV_Recorder::mutex);
+
+    if (FOCV_Recorder::recording && FOCV_Recorder::file.is_open()) {
+        FOCV_Recorder::file.write(reinterpret_cast<const char*>(call.bytes.data()), call.bytes.size());
+    }
+}
+
+void FOCV_Recording::finish(jsi::Runtime& runtime, const jsi::Object& result) {
+    finish(runtime, jsi::Value(runtime, result));
+}
@@ -0,0 +1,125 @@
+//
+//  FOCV_Recorder.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_Recorder_hpp
+#define FOCV_Recorder_hpp
+
+#include <jsi/jsilib.h>
+#include <jsi/jsi.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+using namespace facebook;
+
+// Binary trace layout (little endian):
+//   header:   "FOCVREC" u8 version, u8 flags
+//   snapshot: u8 Snapshot, u32 handle, string type, u32 payload length,
+//             payload of the object
+//   call:     u8 Call, string function, u32 argc, argc * value,
+//             u32 result handle (or FOCV_NoHandle), u64 duration in ns
+// Strings are u32 length + bytes. Values start with a FOCV_RecordTag.
+// Objects are referenced by handles numbered in order of appearance; objects
+// that were created before recording started are written as snapshots;
+// stateful objects (trackers, models, ...) have no snapshot, and calls using
+// them fail on replay.
+static const char FOCV_RecordMagic[7] = { 'F', 'O', 'C', 'V', 'R', 'E', 'C' };
+static const uint8_t FOCV_RecordVersion = 2;
+static const uint8_t FOCV_RecordHashBuffers = 1;
+static const uint32_t FOCV_NoHandle = 0xFFFFFFFF;
+static const uint8_t FOCV_ArrayBufferKind = 0xFF;
+
+enum class FOCV_RecordKind : uint8_t {
+    Call = 1,
+    Snapshot = 2,
+};
+
+enum class FOCV_RecordTag : uint8_t {
+    Undefined = 0,
+    Null,
+    Bool,
+    Number,
+    String,
+    Handle,
+    Buffer,
+    BufferHash,
+    Array,
+    Object,
+};
+
+class FOCV_RecordWriter {
+public:
+    std::vector<uint8_t> bytes;
+
+    template <typename T>
+    void write(T value);
+    void writeString(const std::string& value);
+    void writeBytes(const void* data, size_t length);
+};
+
+template <typename T>
+void FOCV_RecordWriter::write(T value) {
+    writeBytes(&value, sizeof(T));
+}
+
+class FOCV_Recorder {
+private:
+    static std::mutex mutex;
+    static std::ofstream file;
+    static std::unordered_map<std::string, uint32_t> handles;
+    static std::atomic<bool> recording;
+    static bool hashBuffers;
+
+    static uint32_t handleFor(const std::string& id, const std::string& type);
+    static uint32_t registerHandle(const std::string& id);
+    static void writeValue(jsi::Runtime& runtime, const jsi::Value& value, FOCV_RecordWriter& writer);
+    static void writeBuffer(const uint8_t* data, size_t length, uint8_t kind, FOCV_RecordWriter& writer);
+    static void writeSnapshot(const std::string& id, const std::string& type, FOCV_RecordWriter& writer);
+
+public:
+    static bool start(const std::string& path, bool hashBuffers);
+    static void stop();
+    static bool isRecording();
+
+    static void writeMat(const cv::Mat& mat, bool withData, FOCV_RecordWriter& writer);
+    static uint64_t hash(const uint8_t* data, size_t length);
+
+    friend class FOCV_Recording;
+};
+
+// Records a single host function call. Arguments are captured on construction,
+// before the call can modify them; the call is written when `finish` gets the
+// result, and dropped if the call throws.
+class FOCV_Recording {
+private:
+    FOCV_RecordWriter call;
+    std::chrono::steady_clock::time_point start;
+    bool active;
+
+public:
+    FOCV_Recording(jsi::Runtime& runtime, const char* function, const jsi::Value* arguments, size_t count);
+    void finish(jsi::Runtime& runtime, const jsi::Value& result);
+    void finish(jsi::Runtime& runtime, const jsi::Object& result);
+};
+
+#endif /* FOCV_Recorder_hpp */
@@ -0,0 +1,176 @@
+//
+//  FOCV_RemapTransform.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_RemapTransform.hpp"
+
+// Output positions at which warps and undistortions are sampled, including
+// the corners, where lens distortion moves pixels the most.
+static const int FOCV_RemapSampleSteps = 9;
+
+static std::vector<cv::Point2d> sampleGrid(cv::Size size) {
+    std::vector<cv::Point2d> points;
+    points.reserve(FOCV_RemapSampleSteps * FOCV_RemapSampleSteps);
+
+    for (int j = 0; j < FOCV_RemapSampleSteps; j++) {
+        for (int i = 0; i < FOCV_RemapSampleSteps; i++) {
+            points.emplace_back(static_cast<double>(size.width - 1) * i / (FOCV_RemapSampleSteps - 1),
+                                static_cast<double>(size.height - 1) * j / (FOCV_RemapSampleSteps - 1));
+        }
+    }
+
+    return points;
+}
+
+FOCV_RemapTransform::FOCV_RemapTransform(double tolerance) : tolerance(tolerance) {}
+
+bool FOCV_RemapTransform::unchanged(Kind kind, cv::Size size, const cv::Mat& samples) const {
+    return this->kind == kind && this->size == size && this->samples.size() == samples.size()
+        && cv::norm(this->samples, samples, cv::NORM_INF) <= tolerance;
+}
+
+void FOCV_RemapTransform::commit(Kind kind, cv::Size size, const cv::Mat& samples, const cv::Mat& map1, const cv::Mat& map2) {
+    this->kind = kind;
+    this->size = size;
+    this->samples = samples;
+    this->map1 = map1;
+    this->map2 = map2;
+}
+
+void FOCV_RemapTransform::store(Kind kind, cv::Size size, const cv::Mat& samples, const cv::Mat& map) {
+    cv::Mat fixed, table;
+    cv::convertMaps(map, cv::noArray(), fixed, table, CV_16SC2);
+
+    commit(kind, size, samples, fixed, table);
+}
+
+bool FOCV_RemapTransform::setWarp(const cv::Mat& matrix, cv::Size size) {
+    if ((matrix.rows != 2 && matrix.rows != 3) || matrix.cols != 3) {
+        throw std::runtime_error("Remap warp needs a 2x3 or 3x3 matrix");
+    }
+
+    cv::Mat forward = cv::Mat::eye(3, 3, CV_64F);
+    cv::Mat rows = forward.rowRange(0, matrix.rows);
+    matrix.convertTo(rows, CV_64F);
+
+    cv::Mat inverted = forward.inv();
+    cv::Matx33d inverse = inverted;
+
+    // The tables read the source at the inverse of every output position
+    std::vector<cv::Point2d> sources;
+    cv::perspectiveTransform(sampleGrid(size), sources, inverted);
+
+    cv::Mat samples = cv::Mat(sources, true).reshape(1);
+    if (unchanged(Kind::Warp, size, samples)) {
+        return false;
+    }
+
+    cv::Mat map(size, CV_32FC2);
+
+    cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            auto row = map.ptr<cv::Vec2f>(y);
+
+            for (int x = 0; x < size.width; x++) {
+                double w = inverse(2, 0) * x + inverse(2, 1) * y + inverse(2, 2);
+                w = w != 0 ? 1.0 / w : 0;
+
+                row[x][0] = static_cast<float>((inverse(0, 0) * x + inverse(0, 1) * y + inverse(0, 2)) * w);
+                row[x][1] = static_cast<float>((inverse(1, 0) * x + inverse(1, 1) * y + inverse(1, 2)) * w);
+            }
+        }
+    });
+
+    store(Kind::Warp, size, samples, map);
+    return true;
+}
+
+bool FOCV_RemapTransform::setUndistort(const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs, const cv::Mat& newCameraMatrix, cv::Size size) {
+    const cv::Mat& outputMatrix = newCameraMatrix.empty() ? cameraMatrix : newCameraMatrix;
+
+    // Same model as initUndistortRectifyMap: output pixels are normalized with
+    // the output camera and projected through the lens into the source
+    cv::Mat output;
+    outputMatrix.convertTo(output, CV_64F);
+    cv::Matx33d normalize = cv::Mat(output.inv());
+
+    std::vector<cv::Point3d> rays;
+    for (const auto& point : sampleGrid(size)) {
+        cv::Vec3d ray = normalize * cv::Vec3d(point.x, point.y, 1);
+        rays.emplace_back(ray[0] / ray[2], ray[1] / ray[2], 1);
+    }
+
+    std::vector<cv::Point2d> sources;
+    cv::projectPoints(rays, cv::Vec3d(0, 0, 0), cv::Vec3d(0, 0, 0), cameraMatrix, distCoeffs, sources);
+
+    cv::Mat samples = cv::Mat(sources, true).reshape(1);
+    if (unchanged(Kind::Undistort, size, samples)) {
+        return false;
+    }
+
+    cv::Mat fixed, table;
+    cv::initUndistortRectifyMap(cameraMatrix, distCoeffs, cv::noArray(), outputMatrix,
+                                size, CV_16SC2, fixed, table);
+
+    commit(Kind::Undistort, size, samples, fixed, table);
+    return true;
+}
+
+bool FOCV_RemapTransform::setMesh(const cv::Mat& mesh, cv::Size size) {
+    if (mesh.type() != CV_32FC2 || mesh.rows < 2 || mesh.cols < 2) {
+        throw std::runtime_error("Remap mesh must be a CV_32FC2 grid of at least 2x2 nodes");
+    }
+
+    // The nodes are source positions, and the tables interpolate linearly
+    // between them, so no position moves further than the nodes do
+    cv::Mat samples;
+    mesh.convertTo(samples, CV_64F);
+
+    if (unchanged(Kind::Mesh, size, samples)) {
+        return false;
+    }
+
+    if (mesh.size() == size) {
+        store(Kind::Mesh, size, samples, mesh);
+        return true;
+    }
+
+    // Bilinear interpolation between the mesh nodes, corners aligned.
+    cv::Mat map(size, CV_32FC2);
+    double sx = size.width > 1 ? static_cast<double>(mesh.cols - 1) / (size.width - 1) : 0;
+    double sy = size.height > 1 ? static_cast<double>(mesh.rows - 1) / (size.height - 1) : 0;
+
+    cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            double gy = y * sy;
+            int y0 = std::min(static_cast<int>(gy), mesh.rows - 2);
+            float fy = static_cast<float>(gy - y0);
+
+            auto top = mesh.ptr<cv::Vec2f>(y0);
+            auto bottom = mesh.ptr<cv::Vec2f>(y0 + 1);
+            auto row = map.ptr<cv::Vec2f>(y);
+
+            for (int x = 0; x < size.width; x++) {
+                double gx = x * sx;
+                int x0 = std::min(static_cast<int>(gx), mesh.cols - 2);
+                float fx = static_cast<float>(gx - x0);
+
+                cv::Vec2f upper = top[x0] * (1 - fx) + top[x0 + 1] * fx;
+                cv::Vec2f lower = bottom[x0] * (1 - fx) + bottom[x0 + 1] * fx;
+                row[x] = upper * (1 - fy) + lower * fy;
+            }
+        }
+    });
+
+    store(Kind::Mesh, size, samples, map);
+    return true;
+}
+
+void FOCV_RemapTransform::apply(const cv::Mat& src, cv::Mat& dst, int interpolation, int borderMode) const {
+    if (map1.empty()) {
+        throw std::runtime_error("Remap transform has no maps yet");
+    }
+
+    cv::remap(src, dst, map1, map2, interpolation, borderMode);
+}
@@ -0,0 +1,70 @@
+//
+//  FOCV_RemapTransform.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_RemapTransform_hpp
+#define FOCV_RemapTransform_hpp
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+// Geometric transform baked into fixed-point remap tables (CV_16SC2 plus the
+// interpolation table), so every frame only pays for a cv::remap. The tables
+// are rebuilt only when a source position read by the tables moves by more
+// than `tolerance` pixels. Positions are compared on a grid over the output
+// for warps and undistortion, and at the nodes for meshes.
+class FOCV_RemapTransform {
+private:
+    enum class Kind {
+        None,
+        Warp,
+        Undistort,
+        Mesh,
+    };
+
+    double tolerance;
+    Kind kind = Kind::None;
+    cv::Size size;
+    // Source positions (CV_64F) sampled from the current tables
+    cv::Mat samples;
+    cv::Mat map1;
+    cv::Mat map2;
+
+    bool unchanged(Kind kind, cv::Size size, const cv::Mat& samples) const;
+    // Takes over complete tables together with the samples of the transform
+    // they were built from, so a rebuild that throws keeps the previous one.
+    void commit(Kind kind, cv::Size size, const cv::Mat& samples, const cv::Mat& map1, const cv::Mat& map2);
+    void store(Kind kind, cv::Size size, const cv::Mat& samples, const cv::Mat& map);
+
+public:
+    FOCV_RemapTransform(double tolerance);
+
+    // Each setter returns true when the tables were rebuilt.
+
+    // 2x3 affine or 3x3 perspective matrix, mapping source to destination
+    // like warpAffine and warpPerspective.
+    bool setWarp(const cv::Mat& matrix, cv::Size size);
+    bool setUndistort(const cv::Mat& cameraMatrix, const cv::Mat& distCoeffs, const cv::Mat& newCameraMatrix, cv::Size size);
+    // CV_32FC2 grid of source coordinates, spread evenly over the destination
+    // with its corners on the destination corners.
+    bool setMesh(const cv::Mat& mesh, cv::Size size);
+
+    void apply(const cv::Mat& src, cv::Mat& dst, int interpolation, int borderMode) const;
+};
+
+#endif /* FOCV_RemapTransform_hpp */
@@ -8,7 +8,30 @@
 #include "FOCV_Storage.hpp"
 
 std::unordered_map<std::string, std::any> FOCV_Storage::items = std::unordered_map<std::string, std::any>();
+std::unordered_set<std::string> FOCV_Storage::persistent = std::unordered_set<std::string>();
+
+void FOCV_Storage::persist(const std::string& key) {
+  persistent.insert(key);
+}
+
+void FOCV_Storage::release(const std::string& key) {
+  persistent.erase(key);
+  items.erase(key);
+}
 
 void FOCV_Storage::clear() {
-  items.clear();
+  FOCV_TraceScope trace("storage", "clear");
+
+  if (persistent.empty()) {
+    items.clear();
+    return;
+  }
+
+  for (auto it = items.begin(); it != items.end();) {
+    if (persistent.contains(it->first)) {
+      ++it;
+    } else {
+      it = items.erase(it);
+    }
+  }
 }
\ No newline at end of file
@@ -10,7 +10,9 @@
 
 #include <stdio.h>
 #include <any>
+#include <unordered_set>
 #include "UUID.hpp"
+#include "FOCV_Trace.hpp"
 
 #ifdef __cplusplus
     #include <opencv2/opencv.hpp>
@@ -20,6 +22,7 @@ class FOCV_Storage {
 public:
 private:
     static std::unordered_map<std::string, std::any> items;
+    static std::unordered_set<std::string> persistent;
 
 public:
     template <typename T>
@@ -31,11 +34,17 @@ public:
     template <typename T>
     static std::string save(std::string key, T &item);
 
+    // Persistent items (stateful objects like trackers) survive `clear` until
+    // they are released.
+    static void persist(const std::string& key);
+    static void release(const std::string& key);
+
     static void clear();
 };
 
 template <typename T>
 std::string FOCV_Storage::save(T &item) {
+    FOCV_TraceScope trace("storage", "save");
     std::string key = uuid::generate_uuid_v4();
 
     items.insert_or_assign(key, std::make_shared<T>(item));
@@ -45,6 +54,7 @@ std::string FOCV_Storage::save(T &item) {
 
 template <typename T>
 std::string FOCV_Storage::save(std::string key, T &item) {
+    FOCV_TraceScope trace("storage", "save");
     items.insert_or_assign(key, std::make_shared<T>(item));
 
     return key;
@@ -0,0 +1,134 @@
+//
+//  FOCV_TemplateSet.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_TemplateSet.hpp"
+#include <algorithm>
+#include <mutex>
+
+static void toGray(const cv::Mat& src, cv::Mat& dst) {
+    if (src.channels() == 1) {
+        dst = src;
+    } else {
+        cv::cvtColor(src, dst, src.channels() == 4 ? cv::COLOR_RGBA2GRAY : cv::COLOR_RGB2GRAY);
+    }
+}
+
+static float intersectionOverUnion(const FOCV_TemplateMatch& a, const FOCV_TemplateMatch& b) {
+    cv::Rect2f first(a.x, a.y, a.width, a.height);
+    cv::Rect2f second(b.x, b.y, b.width, b.height);
+    float intersection = (first & second).area();
+
+    return intersection / (first.area() + second.area() - intersection);
+}
+
+FOCV_TemplateSet::FOCV_TemplateSet(const std::vector<cv::Mat>& templates, double minScale, double maxScale, int steps, int method) : method(method) {
+    if (method != cv::TM_SQDIFF_NORMED && method != cv::TM_CCORR_NORMED && method != cv::TM_CCOEFF_NORMED) {
+        throw std::runtime_error("Template sets support only the normed matching methods");
+    }
+
+    steps = std::max(1, steps);
+
+    for (size_t i = 0; i < templates.size(); i++) {
+        cv::Mat templ;
+        toGray(templates[i], templ);
+
+        for (int step = 0; step < steps; step++) {
+            double scale = steps == 1 ? minScale : minScale + (maxScale - minScale) * step / (steps - 1);
+            cv::Size size(cvRound(templ.cols * scale), cvRound(templ.rows * scale));
+
+            if (size.width < 4 || size.height < 4) {
+                continue;
+            }
+
+            Entry entry;
+            entry.scale = scale;
+            entry.templateIndex = static_cast<int>(i);
+
+            if (scale == 1.0) {
+                entry.templ = templ.clone();
+            } else {
+                cv::resize(templ, entry.templ, size, 0, 0, scale < 1.0 ? cv::INTER_AREA : cv::INTER_LINEAR);
+            }
+
+            entries.push_back(entry);
+        }
+    }
+}
+
+std::vector<FOCV_TemplateMatch> FOCV_TemplateSet::match(const cv::Mat& image, double threshold, int maxMatches, double overlap) {
+    toGray(image, gray);
+
+    std::vector<FOCV_TemplateMatch> candidates;
+    std::mutex mutex;
+
+    cv::parallel_for_(cv::Range(0, static_cast<int>(entries.size())), [&](const cv::Range& range) {
+        cv::Mat result;
+        std::vector<FOCV_TemplateMatch> local;
+
+        for (int i = range.start; i < range.end; i++) {
+            const auto& entry = entries[i];
+
+            if (entry.templ.cols > gray.cols || entry.templ.rows > gray.rows) {
+                continue;
+            }
+
+            cv::matchTemplate(gray, entry.templ, result, method);
+
+            if (method == cv::TM_SQDIFF_NORMED) {
+                cv::subtract(cv::Scalar::all(1.0), result, result);
+            }
+
+            // Peaks above the threshold, suppressing the neighbourhood of each one
+            for (int n = 0; n < maxMatches; n++) {
+                double score;
+                cv::Point location;
+                cv::minMaxLoc(result, nullptr, &score, nullptr, &location);
+
+                if (score < threshold) {
+                    break;
+                }
+
+                local.push_back({
+                    static_cast<float>(score),
+                    entry.scale,
+                    static_cast<float>(entry.templateIndex),
+                    static_cast<float>(location.x),
+                    static_cast<float>(location.y),
+                    static_cast<float>(entry.templ.cols),
+                    static_cast<float>(entry.templ.rows),
+                });
+
+                cv::Rect suppressed(location.x - entry.templ.cols / 2, location.y - entry.templ.rows / 2, entry.templ.cols, entry.templ.rows);
+                result(suppressed & cv::Rect({}, result.size())).setTo(-1);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        candidates.insert(candidates.end(), local.begin(), local.end());
+    });
+
+    std::sort(candidates.begin(), candidates.end(), [](const FOCV_TemplateMatch& a, const FOCV_TemplateMatch& b) {
+        return a.score > b.score;
+    });
+
+    // Non-maximum suppression across all templates and scales
+    std::vector<FOCV_TemplateMatch> matches;
+
+    for (const auto& candidate : candidates) {
+        if (static_cast<int>(matches.size()) >= maxMatches) {
+            break;
+        }
+
+        bool suppressed = std::any_of(matches.begin(), matches.end(), [&](const FOCV_TemplateMatch& match) {
+            return intersectionOverUnion(candidate, match) > overlap;
+        });
+
+        if (!suppressed) {
+            matches.push_back(candidate);
+        }
+    }
+
+    return matches;
+}
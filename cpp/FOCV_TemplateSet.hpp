@@ -0,0 +1,57 @@
+//
+//  FOCV_TemplateSet.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_TemplateSet_hpp
+#define FOCV_TemplateSet_hpp
+
+#include <stdio.h>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+struct FOCV_TemplateMatch {
+    float score;
+    float scale;
+    float templateIndex;
+    float x;
+    float y;
+    float width;
+    float height;
+};
+
+// Set of grayscale templates, each pre-scaled to every search scale once on
+// creation. Matching runs all (template, scale) pairs in parallel against a
+// single grayscale copy of the image.
+class FOCV_TemplateSet {
+private:
+    struct Entry {
+        cv::Mat templ;
+        float scale;
+        int templateIndex;
+    };
+
+    std::vector<Entry> entries;
+    int method;
+    cv::Mat gray;
+
+public:
+    FOCV_TemplateSet(const std::vector<cv::Mat>& templates, double minScale, double maxScale, int steps, int method);
+
+    std::vector<FOCV_TemplateMatch> match(const cv::Mat& image, double threshold, int maxMatches, double overlap);
+};
+
+#endif /* FOCV_TemplateSet_hpp */
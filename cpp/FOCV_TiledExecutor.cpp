@@ -0,0 +1,162 @@
+//
+//  FOCV_TiledExecutor.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_TiledExecutor.hpp"
+
+FOCV_TiledOp FOCV_TiledOp::parse(const std::string& name) {
+    FOCV_TiledOp op;
+
+    if (name == "blur") {
+        op.kind = FOCV_TiledOpKind::Blur;
+    } else if (name == "GaussianBlur") {
+        op.kind = FOCV_TiledOpKind::GaussianBlur;
+    } else if (name == "medianBlur") {
+        op.kind = FOCV_TiledOpKind::MedianBlur;
+    } else if (name == "morphologyEx") {
+        op.kind = FOCV_TiledOpKind::Morphology;
+    } else if (name == "threshold") {
+        op.kind = FOCV_TiledOpKind::Threshold;
+    } else if (name == "adaptiveThreshold") {
+        op.kind = FOCV_TiledOpKind::AdaptiveThreshold;
+    } else if (name == "cvtColor") {
+        op.kind = FOCV_TiledOpKind::CvtColor;
+    } else {
+        throw std::runtime_error("Operation " + name + " can not run on tiles");
+    }
+
+    return op;
+}
+
+// Conversions that map every pixel on its own and keep the image size. Bayer
+// demosaicing reads neighbours and the subsampled YUV layouts change the
+// number of rows, so they can't run on tiles.
+static bool isPointwiseColorCode(int code) {
+    return (code >= cv::COLOR_BGR2BGRA && code <= cv::COLOR_RGB2Lab)
+        || (code >= cv::COLOR_BGR2Luv && code <= cv::COLOR_HLS2RGB)
+        || (code >= cv::COLOR_BGR2HSV_FULL && code <= cv::COLOR_YUV2RGB);
+}
+
+int FOCV_TiledOp::halo() const {
+    switch (kind) {
+        case FOCV_TiledOpKind::Blur:
+        case FOCV_TiledOpKind::MedianBlur:
+            return ksize / 2;
+        case FOCV_TiledOpKind::GaussianBlur:
+            // Covers the kernel GaussianBlur derives from sigma for any depth
+            return ksize > 0 ? ksize / 2 : cvCeil(sigma * 4) + 1;
+        case FOCV_TiledOpKind::Morphology: {
+            // Opening, closing and the derived operations erode and dilate in sequence
+            int passes = (type == cv::MORPH_ERODE || type == cv::MORPH_DILATE) ? 1 : 2;
+            return (ksize / 2) * iterations * passes;
+        }
+        case FOCV_TiledOpKind::AdaptiveThreshold:
+            return ksize / 2;
+        case FOCV_TiledOpKind::Threshold:
+        case FOCV_TiledOpKind::CvtColor:
+            return 0;
+    }
+
+    return 0;
+}
+
+void FOCV_TiledOp::apply(const cv::Mat& src, cv::Mat& dst) const {
+    switch (kind) {
+        case FOCV_TiledOpKind::Blur:
+            cv::blur(src, dst, cv::Size(ksize, ksize));
+            break;
+        case FOCV_TiledOpKind::GaussianBlur:
+            cv::GaussianBlur(src, dst, cv::Size(ksize, ksize), sigma);
+            break;
+        case FOCV_TiledOpKind::MedianBlur:
+            cv::medianBlur(src, dst, ksize);
+            break;
+        case FOCV_TiledOpKind::Morphology: {
+            cv::Mat kernel = cv::getStructuringElement(shape, cv::Size(ksize, ksize));
+            cv::morphologyEx(src, dst, type, kernel, cv::Point(-1, -1), iterations);
+        } break;
+        case FOCV_TiledOpKind::Threshold:
+            cv::threshold(src, dst, thresh, maxValue, type);
+            break;
+        case FOCV_TiledOpKind::AdaptiveThreshold:
+            cv::adaptiveThreshold(src, dst, maxValue, method, type, ksize, c);
+            break;
+        case FOCV_TiledOpKind::CvtColor:
+            cv::cvtColor(src, dst, type);
+            break;
+    }
+}
+
+int FOCV_TiledExecutor::tileSize(const cv::Mat& src, int halo, const FOCV_TiledOptions& options) {
+    if (options.tileSize > 0) {
+        return options.tileSize;
+    }
+
+    // (side + 2 * halo)^2 * elemSize * 2 buffers = cacheSize
+    double side = std::sqrt(static_cast<double>(options.cacheSize) / (2.0 * src.elemSize())) - 2.0 * halo;
+
+    return std::max(64, static_cast<int>(side) & ~15);
+}
+
+cv::Mat FOCV_TiledExecutor::run(const cv::Mat& src, const std::vector<FOCV_TiledOp>& ops, const FOCV_TiledOptions& options) {
+    for (const auto& op : ops) {
+        if (op.kind == FOCV_TiledOpKind::Threshold && (op.type & (cv::THRESH_OTSU | cv::THRESH_TRIANGLE))) {
+            throw std::runtime_error("Automatic thresholds depend on the whole image and can not run on tiles");
+        }
+        if (op.kind == FOCV_TiledOpKind::CvtColor && !isPointwiseColorCode(op.type)) {
+            throw std::runtime_error("Color conversion " + std::to_string(op.type) + " reads neighbours or changes the size and can not run on tiles");
+        }
+    }
+
+    if (src.empty() || ops.empty()) {
+        return src.clone();
+    }
+
+    int halo = 0;
+    for (const auto& op : ops) {
+        halo += op.halo();
+    }
+
+    int side = tileSize(src, halo, options);
+    int gridCols = (src.cols + side - 1) / side;
+    int gridRows = (src.rows + side - 1) / side;
+    cv::Rect bounds({}, src.size());
+
+    // Runs the chain on one tile and returns the output part without the halo
+    auto process = [&](int index, cv::Mat& first, cv::Mat& second) -> cv::Rect {
+        cv::Rect tile = cv::Rect((index % gridCols) * side, (index / gridCols) * side, side, side) & bounds;
+        cv::Rect padded = cv::Rect(tile.x - halo, tile.y - halo, tile.width + 2 * halo, tile.height + 2 * halo) & bounds;
+
+        // Operations on a submatrix would read the neighbouring pixels of the
+        // parent, a copy makes them use the image border at the image edges.
+        src(padded).copyTo(first);
+
+        for (const auto& op : ops) {
+            op.apply(first, second);
+            std::swap(first, second);
+        }
+
+        return cv::Rect(tile.x - padded.x, tile.y - padded.y, tile.width, tile.height);
+    };
+
+    // The first tile gives the type of the result
+    cv::Mat first, second;
+    cv::Rect inner = process(0, first, second);
+
+    cv::Mat dst(src.size(), first.type());
+    first(inner).copyTo(dst(cv::Rect(0, 0, inner.width, inner.height)));
+
+    cv::parallel_for_(cv::Range(1, gridCols * gridRows), [&](const cv::Range& range) {
+        cv::Mat first, second;
+
+        for (int index = range.start; index < range.end; index++) {
+            cv::Rect inner = process(index, first, second);
+            cv::Rect tile((index % gridCols) * side, (index / gridCols) * side, inner.width, inner.height);
+
+            first(inner).copyTo(dst(tile));
+        }
+    });
+
+    return dst;
+}
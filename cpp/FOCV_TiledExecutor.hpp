@@ -0,0 +1,76 @@
+//
+//  FOCV_TiledExecutor.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_TiledExecutor_hpp
+#define FOCV_TiledExecutor_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef __cplusplus
+#undef YES
+#undef NO
+#include <opencv2/opencv.hpp>
+using namespace cv;
+#if __has_feature(objc_bool)
+#define YES __objc_yes
+#define NO  __objc_no
+#else
+#define YES ((BOOL)1)
+#define NO  ((BOOL)0)
+#endif
+#endif
+
+enum class FOCV_TiledOpKind {
+    Blur,
+    GaussianBlur,
+    MedianBlur,
+    Morphology,
+    Threshold,
+    AdaptiveThreshold,
+    CvtColor,
+};
+
+// One step of a tiled chain. Only the fields of the kind are used, with the
+// meaning of the OpenCV function of the same name.
+struct FOCV_TiledOp {
+    FOCV_TiledOpKind kind;
+    int ksize = 3;
+    double sigma = 0;
+    // MorphTypes, ThresholdTypes or ColorConversionCodes
+    int type = 0;
+    int shape = cv::MORPH_RECT;
+    int iterations = 1;
+    double thresh = 0;
+    double maxValue = 255;
+    int method = cv::ADAPTIVE_THRESH_MEAN_C;
+    double c = 0;
+
+    // Throws for unknown names and for operations that need the whole image
+    static FOCV_TiledOp parse(const std::string& name);
+    // Pixels of context the operation reads around each output pixel
+    int halo() const;
+    void apply(const cv::Mat& src, cv::Mat& dst) const;
+};
+
+struct FOCV_TiledOptions {
+    // Side of the output tiles. 0 derives it from `cacheSize`.
+    int tileSize = 0;
+    // Working set of a tile, source and one intermediate with their halo
+    size_t cacheSize = 256 * 1024;
+};
+
+// Runs a chain of neighbourhood operations tile by tile on worker threads.
+// Every tile is cut from the source with the summed halo of the chain, so
+// the result matches running the chain on the whole image while only a few
+// tile sized intermediates exist at any time.
+class FOCV_TiledExecutor {
+public:
+    static cv::Mat run(const cv::Mat& src, const std::vector<FOCV_TiledOp>& ops, const FOCV_TiledOptions& options);
+    static int tileSize(const cv::Mat& src, int halo, const FOCV_TiledOptions& options);
+};
+
+#endif /* FOCV_TiledExecutor_hpp */
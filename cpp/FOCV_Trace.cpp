@@ -0,0 +1,191 @@
+//
+//  FOCV_Trace.cpp
+//  react-native-fast-opencv
+//
+
+#include "FOCV_Trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+std::atomic<bool> FOCV_Trace::enabled(false);
+std::atomic<uint64_t> FOCV_Trace::head(0);
+std::atomic<FOCV_TraceBuffer*> FOCV_Trace::buffer(nullptr);
+std::vector<std::unique_ptr<FOCV_TraceBuffer>> FOCV_Trace::buffers;
+std::atomic<size_t> FOCV_Trace::capacity(0);
+
+static const std::chrono::steady_clock::time_point traceOrigin = std::chrono::steady_clock::now();
+static std::atomic<uint32_t> nextThreadId(1);
+
+static uint32_t currentThreadId() {
+    thread_local uint32_t id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+static void appendEscaped(std::ostringstream& out, const char* text) {
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) >= 0x20) {
+            out << *c;
+        }
+    }
+}
+
+void FOCV_Trace::start(size_t requestedCapacity) {
+    if (enabled.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    requestedCapacity = std::min(std::max<size_t>(requestedCapacity, 1), FOCV_TraceMaxCapacity);
+
+    size_t size = 1;
+    while (size < requestedCapacity) {
+        size <<= 1;
+    }
+
+    // A writer that passed isEnabled() before the last stop() may still hold
+    // the current buffer, so it is kept instead of freed. Smaller requests
+    // reuse the larger buffer.
+    FOCV_TraceBuffer* current = buffer.load(std::memory_order_acquire);
+
+    if (current == nullptr || current->capacity < size) {
+        auto next = std::make_unique<FOCV_TraceBuffer>();
+        next->events.reset(new FOCV_TraceEvent[size]);
+        next->capacity = size;
+
+        current = next.get();
+        buffers.push_back(std::move(next));
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        current->events[i].sequence.store(0, std::memory_order_relaxed);
+    }
+
+    capacity.store(size, std::memory_order_relaxed);
+    buffer.store(current, std::memory_order_release);
+
+    head.store(0, std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_release);
+}
+
+// Both are powers of two. The minimum keeps a writer that still holds a
+// smaller buffer from an earlier session inside of it.
+size_t FOCV_Trace::slots(const FOCV_TraceBuffer* buffer) {
+    return std::min(capacity.load(std::memory_order_relaxed), buffer->capacity);
+}
+
+void FOCV_Trace::stop() {
+    enabled.store(false, std::memory_order_release);
+}
+
+uint64_t FOCV_Trace::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - traceOrigin).count();
+}
+
+void FOCV_Trace::record(const char* category, const char* name, uint64_t start, uint64_t end) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    FOCV_TraceBuffer* current = buffer.load(std::memory_order_acquire);
+    if (current == nullptr) {
+        return;
+    }
+
+    uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+    FOCV_TraceEvent& event = current->events[index & (slots(current) - 1)];
+
+    // Seqlock-style publish: readers skip the slot until the sequence matches.
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.category = category;
+    strncpy(event.name, name, sizeof(event.name) - 1);
+    event.name[sizeof(event.name) - 1] = '\0';
+    event.start = start;
+    event.duration = end - start;
+    event.thread = currentThreadId();
+
+    event.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::string FOCV_Trace::exportJSON() {
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    FOCV_TraceBuffer* current = buffer.load(std::memory_order_acquire);
+    size_t size = current != nullptr ? slots(current) : 0;
+    uint64_t end = current != nullptr ? head.load(std::memory_order_acquire) : 0;
+    uint64_t begin = end > size ? end - size : 0;
+    bool first = true;
+
+    for (uint64_t index = begin; index < end; index++) {
+        FOCV_TraceEvent& slot = current->events[index & (size - 1)];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != index + 1) {
+            continue;
+        }
+
+        const char* category = slot.category;
+        char name[sizeof(slot.name)];
+        memcpy(name, slot.name, sizeof(name));
+        name[sizeof(name) - 1] = '\0';
+        uint64_t start = slot.start;
+        uint64_t duration = slot.duration;
+        uint32_t thread = slot.thread;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        if (!first) {
+            out << ",";
+        }
+        first = false;
+
+        out << "{\"name\":\"";
+        appendEscaped(out, name);
+        out << "\",\"cat\":\"";
+        appendEscaped(out, category);
+        out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+            << ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+    }
+
+    out << "]}";
+    return out.str();
+}
+
+bool FOCV_Trace::exportToFile(const std::string& path) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << exportJSON();
+    return file.good();
+}
+
+FOCV_TraceScope::FOCV_TraceScope(const char* category, const char* name) {
+    this->active = FOCV_Trace::isEnabled();
+
+    if (this->active) {
+        this->category = category;
+        this->name = name;
+        this->start = FOCV_Trace::now();
+    }
+}
+
+FOCV_TraceScope::FOCV_TraceScope(const char* category, const std::string& name) : FOCV_TraceScope(category, name.c_str()) {}
+
+FOCV_TraceScope::~FOCV_TraceScope() {
+    if (this->active) {
+        FOCV_Trace::record(this->category, this->name, this->start, FOCV_Trace::now());
+    }
+}
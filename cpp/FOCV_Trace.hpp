@@ -0,0 +1,81 @@
+//
+//  FOCV_Trace.hpp
+//  react-native-fast-opencv
+//
+
+#ifndef FOCV_Trace_hpp
+#define FOCV_Trace_hpp
+
+#include <stdio.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct FOCV_TraceEvent {
+    std::atomic<uint64_t> sequence;
+    const char* category;
+    char name[48];
+    uint64_t start;
+    uint64_t duration;
+    uint32_t thread;
+};
+
+// Largest ring buffer `start` allocates, about 90 MB of events
+static const size_t FOCV_TraceMaxCapacity = 1 << 20;
+
+struct FOCV_TraceBuffer {
+    std::unique_ptr<FOCV_TraceEvent[]> events;
+    size_t capacity;
+};
+
+// Timeline of native work exported in the Chrome trace format, so it can be
+// opened in chrome://tracing or ui.perfetto.dev. Events are written into a
+// fixed-size ring buffer without locks; when it is full the oldest events are
+// overwritten. Tracing is disabled by default and costs a single atomic load
+// per scope until `start` is called.
+class FOCV_Trace {
+private:
+    static std::atomic<bool> enabled;
+    static std::atomic<uint64_t> head;
+    // Writers load the buffer once per event. Buffers are never freed, a
+    // writer that raced with `stop` may still be writing into an old one;
+    // they are only replaced to grow, so at most a few are ever allocated.
+    static std::atomic<FOCV_TraceBuffer*> buffer;
+    static std::vector<std::unique_ptr<FOCV_TraceBuffer>> buffers;
+    // Slots of the current session, a power of two. A reused buffer can be
+    // larger than requested, only this many of its slots are written.
+    static std::atomic<size_t> capacity;
+
+    static size_t slots(const FOCV_TraceBuffer* buffer);
+
+public:
+    static void start(size_t capacity);
+    static void stop();
+    static bool isEnabled();
+
+    static uint64_t now();
+    static void record(const char* category, const char* name, uint64_t start, uint64_t end);
+
+    static std::string exportJSON();
+    static bool exportToFile(const std::string& path);
+};
+
+class FOCV_TraceScope {
+private:
+    const char* category;
+    const char* name;
+    uint64_t start;
+    bool active;
+
+public:
+    FOCV_TraceScope(const char* category, const char* name);
+    FOCV_TraceScope(const char* category, const std::string& name);
+    ~FOCV_TraceScope();
+};
+
+inline bool FOCV_Trace::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+#endif /* FOCV_Trace_hpp */
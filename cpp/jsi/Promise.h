@@ -4,7 +4,7 @@
 #include <utility>
 #include <vector>
 
-#ifdef ANDROID
+#if defined(ANDROID) || defined(FOCV_HOST_BUILD)
 #include <ReactCommon/CallInvoker.h>
 #else
 #include <React-callinvoker/ReactCommon/CallInvoker.h>
@@ -9,6 +9,13 @@
 #include "FOCV_Object.hpp"
 #include "ConvertImage.hpp"
 #include "FOCV_JsiObject.hpp"
+#include "FOCV_Trace.hpp"
+#include "FOCV_Recorder.hpp"
+#include "FOCV_FileIO.hpp"
+#include "FOCV_BatchDecode.hpp"
+#include "FOCV_MatFile.hpp"
+#include "FOCV_DnnNet.hpp"
+#include <algorithm>
 #include "opencv2/opencv.hpp"
 
 using namespace mrousavy;
@@ -34,7 +41,10 @@ void OpenCVPlugin::installOpenCV(jsi::Runtime& runtime, std::shared_ptr<react::C
     
 }
 
-OpenCVPlugin::OpenCVPlugin(std::shared_ptr<react::CallInvoker> callInvoker) : _callInvoker(callInvoker) {}
+OpenCVPlugin::OpenCVPlugin(std::shared_ptr<react::CallInvoker> callInvoker)
+    : _callInvoker(callInvoker),
+      _pendingDecodes(std::make_shared<std::unordered_map<Promise*, std::shared_ptr<Promise>>>()),
+      _decodeWorker(std::make_shared<FOCV_DecodeWorker>()) {}
 
 jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propNameId)
 {
@@ -46,6 +56,8 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
         [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
             size_t count) -> jsi::Object {
 
+        FOCV_TraceScope trace("conversion", "frameBufferToMat");
+        FOCV_Recording recording(runtime, "frameBufferToMat", arguments, count);
         jsi::Object input = arguments[2].asObject(runtime);
         TypedArrayBase inputBuffer = getTypedArray(runtime, std::move(input));
         auto vec = inputBuffer.toVector(runtime);
@@ -53,7 +65,10 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
         cv::Mat mat(arguments[0].asNumber(), arguments[1].asNumber(), CV_8UC3, vec.data());
         auto id = FOCV_Storage::save(mat);
 
-        return FOCV_JsiObject::wrap(runtime, "mat", id);
+        auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+        recording.finish(runtime, result);
+
+        return result;
     });
   }
   else if (propName == "bufferToMat") {
@@ -62,6 +77,8 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
         [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
             size_t count) -> jsi::Object {
 
+        FOCV_TraceScope trace("conversion", "bufferToMat");
+        FOCV_Recording recording(runtime, "bufferToMat", arguments, count);
         jsi::Object input = arguments[2].asObject(runtime);
         TypedArrayBase inputBuffer = getTypedArray(runtime, std::move(input));
         auto vec = inputBuffer.toVector(runtime);
@@ -86,7 +103,10 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
         cv::Mat mat(rows, cols, matType, vec.data());
         auto id = FOCV_Storage::save(mat);
 
-        return FOCV_JsiObject::wrap(runtime, "mat", id);
+        auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+        recording.finish(runtime, result);
+
+        return result;
     });
   }
   else if (propName == "bufferF32ToMat") {
@@ -95,6 +115,8 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
         [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
             size_t count) -> jsi::Object {
 
+        FOCV_TraceScope trace("conversion", "bufferF32ToMat");
+        FOCV_Recording recording(runtime, "bufferF32ToMat", arguments, count);
         jsi::Object input = arguments[2].asObject(runtime);
         TypedArrayBase inputBuffer = getTypedArray(runtime, std::move(input));
         auto vec = inputBuffer.toVector32F(runtime);
@@ -122,7 +144,10 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
         memcpy(mat.data, vec.data(), bufferSize * sizeof(float));
         auto id = FOCV_Storage::save(mat);
 
-        return FOCV_JsiObject::wrap(runtime, "mat", id);
+        auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+        recording.finish(runtime, result);
+
+        return result;
     });
   }
   else if (propName == "base64ToMat") {
@@ -131,20 +156,414 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
           [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
               size_t count) -> jsi::Object {
 
+          FOCV_TraceScope trace("conversion", "base64ToMat");
+          FOCV_Recording recording(runtime, "base64ToMat", arguments, count);
           std::string base64 = arguments[0].asString(runtime).utf8(runtime);
 
                 auto mat = ImageConverter::str2mat(base64);
                 auto id = FOCV_Storage::save(mat);
 
-                return FOCV_JsiObject::wrap(runtime, "mat", id);
+                auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+                recording.finish(runtime, result);
+
+                return result;
             });
     }
+  else if (propName == "bytesToMat") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "bytesToMat"), 1,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "bytesToMat");
+          FOCV_Recording recording(runtime, "bytesToMat", arguments, count);
+          auto input = arguments[0].asObject(runtime);
+          cv::Mat mat;
+
+          if (input.isArrayBuffer(runtime)) {
+              auto buffer = input.getArrayBuffer(runtime);
+              mat = ImageConverter::bytes2mat(buffer.data(runtime), buffer.size(runtime));
+          } else {
+              auto typedArray = getTypedArray(runtime, input);
+              auto data = typedArray.getBuffer(runtime).data(runtime) + typedArray.byteOffset(runtime);
+              mat = ImageConverter::bytes2mat(data, typedArray.byteLength(runtime));
+          }
+
+          auto id = FOCV_Storage::save(mat);
+
+          auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "matToBytes") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "matToBytes"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Value {
+
+          FOCV_TraceScope trace("conversion", "matToBytes");
+          FOCV_Recording recording(runtime, "matToBytes", arguments, count);
+          std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
+
+          ImageEncodeOptions options;
+          options.format = count > 1 && arguments[1].isString() ? arguments[1].asString(runtime).utf8(runtime) : "jpg";
+          // OpenCV default JPEG quality
+          options.quality = 95;
+
+          const auto& bytes = ImageConverter::encode(*FOCV_Storage::get<cv::Mat>(id), options);
+          auto arr = TypedArray<TypedArrayKind::Uint8Array>(runtime, bytes.size());
+          arr.updateUnsafe(runtime, const_cast<uint8_t*>(bytes.data()), bytes.size());
+
+          jsi::Value result(runtime, arr.getBuffer(runtime));
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "encodeMat") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "encodeMat"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Value {
+
+          FOCV_TraceScope trace("conversion", "encodeMat");
+          FOCV_Recording recording(runtime, "encodeMat", arguments, count);
+          auto result = FOCV_Object::encode(runtime, arguments, count);
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "imread") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "imread"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "imread");
+          FOCV_Recording recording(runtime, "imread", arguments, count);
+          std::string path = arguments[0].asString(runtime).utf8(runtime);
+          int flags = count > 1 && arguments[1].isNumber() ? arguments[1].asNumber() : cv::IMREAD_COLOR;
+
+          auto mat = FOCV_FileIO::read(path, flags);
+          auto id = FOCV_Storage::save(mat);
+
+          auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "loadNet") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "loadNet"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "loadNet");
+          FOCV_Recording recording(runtime, "loadNet", arguments, count);
+          std::string path = arguments[0].asString(runtime).utf8(runtime);
+          std::string config;
+          int threads = 0;
+
+          if (count > 1 && arguments[1].isObject()) {
+              auto options = arguments[1].asObject(runtime);
+
+              auto configPath = options.getProperty(runtime, "config");
+              if (configPath.isString()) {
+                  config = configPath.asString(runtime).utf8(runtime);
+              }
+
+              // Only applied while this net runs forward
+              auto threadCount = options.getProperty(runtime, "threads");
+              if (threadCount.isNumber()) {
+                  threads = std::max(0.0, threadCount.asNumber());
+              }
+          }
+
+          FOCV_DnnNet net(path, config, threads);
+          auto id = FOCV_Storage::save(net);
+          FOCV_Storage::persist(id);
+
+          auto result = FOCV_JsiObject::wrap(runtime, "dnn_net", id);
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "forward") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "forward"), 3,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "forward");
+          FOCV_Recording recording(runtime, "forward", arguments, count);
+          auto result = FOCV_Object::forward(runtime, arguments, count);
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "processTiled") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "processTiled"), 3,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "processTiled");
+          FOCV_Recording recording(runtime, "processTiled", arguments, count);
+          auto result = FOCV_Object::processTiled(runtime, arguments, count);
+          recording.finish(runtime, result);
+
+          return result;
+      });
+  }
+  else if (propName == "imwrite") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "imwrite"), 3,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Value {
+
+          FOCV_TraceScope trace("conversion", "imwrite");
+          FOCV_Recording recording(runtime, "imwrite", arguments, count);
+          std::string path = arguments[0].asString(runtime).utf8(runtime);
+          std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[1]);
+          std::vector<int> params;
+
+          if (count > 2 && arguments[2].isObject()) {
+              auto array = arguments[2].asObject(runtime).asArray(runtime);
+
+              for (size_t i = 0; i < array.size(runtime); i++) {
+                  params.push_back(array.getValueAtIndex(runtime, i).asNumber());
+              }
+          }
+
+          FOCV_FileIO::write(path, *FOCV_Storage::get<cv::Mat>(id), params);
+          recording.finish(runtime, jsi::Value(true));
+
+          return true;
+      });
+  }
+  else if (propName == "batchDecode") {
+      auto callInvoker = _callInvoker;
+      // Weak, so the function does not keep the plugin's worker alive after the plugin is gone
+      std::weak_ptr<std::unordered_map<Promise*, std::shared_ptr<Promise>>> weakPending = _pendingDecodes;
+      std::weak_ptr<FOCV_DecodeWorker> weakWorker = _decodeWorker;
+
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "batchDecode"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Value {
+
+          FOCV_TraceScope trace("conversion", "batchDecode");
+          FOCV_Recording recording(runtime, "batchDecode", arguments, count);
+
+          if (callInvoker == nullptr) {
+              throw std::runtime_error("batchDecode needs a CallInvoker to resolve on the JS thread");
+          }
+
+          auto pending = weakPending.lock();
+          auto worker = weakWorker.lock();
+
+          if (pending == nullptr || worker == nullptr) {
+              throw std::runtime_error("batchDecode was called after OpenCV was unloaded");
+          }
+
+          FOCV_DecodeOptions options;
+          auto stringKind = FOCV_DecodeSourceKind::Base64;
+
+          if (count > 1 && arguments[1].isObject()) {
+              auto object = arguments[1].asObject(runtime);
+              auto flags = object.getProperty(runtime, "flags");
+              auto width = object.getProperty(runtime, "width");
+              auto height = object.getProperty(runtime, "height");
+              auto strings = object.getProperty(runtime, "strings");
+
+              if (flags.isNumber()) {
+                  options.flags = flags.asNumber();
+              }
+              if (width.isNumber() && height.isNumber()) {
+                  options.box = cv::Size(width.asNumber(), height.asNumber());
+              }
+              if (strings.isString() && strings.asString(runtime).utf8(runtime) == "path") {
+                  stringKind = FOCV_DecodeSourceKind::Path;
+              }
+          }
+
+          // Inputs are copied out of JS memory here, the workers never touch the runtime
+          auto array = arguments[0].asObject(runtime).asArray(runtime);
+          auto sources = std::make_shared<std::vector<FOCV_DecodeSource>>(array.size(runtime));
+
+          for (size_t i = 0; i < sources->size(); i++) {
+              auto item = array.getValueAtIndex(runtime, i);
+              auto& source = sources->at(i);
+
+              if (item.isString()) {
+                  source.kind = stringKind;
+                  source.text = item.asString(runtime).utf8(runtime);
+                  continue;
+              }
+
+              auto object = item.asObject(runtime);
+              source.kind = FOCV_DecodeSourceKind::Bytes;
+
+              if (object.isArrayBuffer(runtime)) {
+                  auto buffer = object.getArrayBuffer(runtime);
+                  source.bytes.assign(buffer.data(runtime), buffer.data(runtime) + buffer.size(runtime));
+              } else {
+                  auto typedArray = getTypedArray(runtime, object);
+                  auto data = typedArray.getBuffer(runtime).data(runtime) + typedArray.byteOffset(runtime);
+                  source.bytes.assign(data, data + typedArray.byteLength(runtime));
+              }
+          }
+
+          auto result = Promise::createPromise(runtime, [=](std::shared_ptr<Promise> promise) {
+              auto key = promise.get();
+              pending->emplace(key, std::move(promise));
+
+              worker->submit([=]() {
+                  auto mats = std::make_shared<std::vector<cv::Mat>>();
+                  auto errors = std::make_shared<std::vector<std::string>>();
+                  std::string failure;
+
+                  try {
+                      *mats = FOCV_BatchDecode::decode(*sources, options, *errors);
+                  } catch (const std::exception& e) {
+                      failure = e.what();
+                  }
+
+                  // Storage and the promise are only used on the JS thread
+                  callInvoker->invokeAsync([weakPending, key, mats, errors, failure]() {
+                      auto pending = weakPending.lock();
+
+                      if (pending == nullptr || pending->count(key) == 0) {
+                          return;
+                      }
+
+                      auto promise = pending->at(key);
+                      pending->erase(key);
+
+                      if (!failure.empty()) {
+                          promise->reject(failure);
+                          return;
+                      }
+
+                      auto& runtime = promise->runtime;
+                      auto failed = jsi::Array(runtime, static_cast<size_t>(std::count_if(errors->begin(), errors->end(), [](const std::string& error) { return !error.empty(); })));
+                      size_t index = 0;
+
+                      for (size_t i = 0; i < errors->size(); i++) {
+                          if (errors->at(i).empty()) {
+                              continue;
+                          }
+
+                          jsi::Object item(runtime);
+                          item.setProperty(runtime, "index", jsi::Value(static_cast<double>(i)));
+                          item.setProperty(runtime, "message", jsi::String::createFromUtf8(runtime, errors->at(i)));
+                          failed.setValueAtIndex(runtime, index++, item);
+                      }
+
+                      auto id = FOCV_Storage::save(*mats);
+                      jsi::Object value(runtime);
+
+                      value.setProperty(runtime, "images", FOCV_JsiObject::wrap(runtime, "mat_vector", id));
+                      value.setProperty(runtime, "failed", failed);
+                      promise->resolve(std::move(value));
+                  });
+              });
+          });
+
+          recording.finish(runtime, result);
+          return result;
+      });
+  }
+  else if (propName == "saveMat") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "saveMat"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Value {
+
+          FOCV_TraceScope trace("conversion", "saveMat");
+          FOCV_Recording recording(runtime, "saveMat", arguments, count);
+          std::string path = arguments[0].asString(runtime).utf8(runtime);
+          std::string objectType = FOCV_JsiObject::type_from_wrap(runtime, arguments[1]);
+          std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[1]);
+
+          if (objectType == "mat") {
+              FOCV_MatFile::write(path, FOCV_MatFileKind::Mat, { *FOCV_Storage::get<cv::Mat>(id) });
+          } else if (objectType == "mat_vector") {
+              FOCV_MatFile::write(path, FOCV_MatFileKind::MatVector, *FOCV_Storage::get<std::vector<cv::Mat>>(id));
+          } else if (objectType == "point_vector") {
+              auto points = FOCV_Storage::get<std::vector<cv::Point>>(id);
+              FOCV_MatFile::write(path, FOCV_MatFileKind::PointVector, { cv::Mat(*points, false) });
+          } else {
+              throw std::runtime_error("saveMat supports mat, mat_vector and point_vector");
+          }
+
+          recording.finish(runtime, jsi::Value(true));
+          return true;
+      });
+  }
+  else if (propName == "loadMat") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "loadMat"), 2,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "loadMat");
+          FOCV_Recording recording(runtime, "loadMat", arguments, count);
+          std::string path = arguments[0].asString(runtime).utf8(runtime);
+          bool copy = count > 1 && arguments[1].isBool() && arguments[1].getBool();
+
+          std::vector<cv::Mat> mats;
+          auto kind = FOCV_MatFile::read(path, mats);
+
+          // Without a copy, the Mats keep the mapping alive until the last one is released
+          if (copy) {
+              for (auto& mat : mats) {
+                  mat = mat.clone();
+              }
+          }
+
+          jsi::Object result(runtime);
+
+          switch (kind) {
+              case FOCV_MatFileKind::Mat: {
+                  cv::Mat mat = mats.empty() ? cv::Mat() : mats[0];
+                  result = FOCV_JsiObject::wrap(runtime, "mat", FOCV_Storage::save(mat));
+              } break;
+              case FOCV_MatFileKind::MatVector: {
+                  result = FOCV_JsiObject::wrap(runtime, "mat_vector", FOCV_Storage::save(mats));
+              } break;
+              case FOCV_MatFileKind::PointVector: {
+                  std::vector<cv::Point> points;
+                  if (!mats.empty() && !mats[0].empty()) {
+                      if (mats[0].type() != CV_32SC2 || !mats[0].isContinuous()) {
+                          throw std::runtime_error("Corrupted point vector in Mat file " + path);
+                      }
+                      points.assign(mats[0].ptr<cv::Point>(), mats[0].ptr<cv::Point>() + mats[0].total());
+                  }
+                  result = FOCV_JsiObject::wrap(runtime, "point_vector", FOCV_Storage::save(points));
+              } break;
+              default:
+                  throw std::runtime_error("Unknown payload in Mat file " + path);
+          }
+
+          recording.finish(runtime, result);
+          return result;
+      });
+  }
   else if (propName == "matToBuffer") {
       return jsi::Function::createFromHostFunction(
           runtime, jsi::PropNameID::forAscii(runtime, "matToBuffer"), 1,
           [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
               size_t count) -> jsi::Object {
 
+                  FOCV_TraceScope trace("conversion", "matToBuffer");
+                  FOCV_Recording recording(runtime, "matToBuffer", arguments, count);
                   std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
                   auto mat = *FOCV_Storage::get<cv::Mat>(id);
 
@@ -167,15 +586,33 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
                       value.setProperty(runtime, "buffer", arr);
                   }
 
+                  recording.finish(runtime, value);
                   return value;
       });
+    } else if (propName == "vectorToBuffer") {
+      return jsi::Function::createFromHostFunction(
+          runtime, jsi::PropNameID::forAscii(runtime, "vectorToBuffer"), 1,
+          [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
+              size_t count) -> jsi::Object {
+
+          FOCV_TraceScope trace("conversion", "vectorToBuffer");
+          FOCV_Recording recording(runtime, "vectorToBuffer", arguments, count);
+          auto result = FOCV_Object::convertToBuffer(runtime, arguments);
+          recording.finish(runtime, result);
+
+          return result;
+      });
     } else if (propName == "createObject") {
       return jsi::Function::createFromHostFunction(
           runtime, jsi::PropNameID::forAscii(runtime, "createObject"), 1,
           [=](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments,
               size_t count) -> jsi::Object {
 
-          return FOCV_Object::create(runtime, arguments);
+          FOCV_Recording recording(runtime, "createObject", arguments, count);
+          auto result = FOCV_Object::create(runtime, arguments, count);
+          recording.finish(runtime, result);
+
+          return result;
       });
     }
     else if (propName == "toJSValue")
@@ -185,7 +622,12 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
             [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
                 size_t count) -> jsi::Object
             {
-                return FOCV_Object::convertToJSI(runtime, arguments);
+                FOCV_TraceScope trace("conversion", "toJSValue");
+                FOCV_Recording recording(runtime, "toJSValue", arguments, count);
+                auto result = FOCV_Object::convertToJSI(runtime, arguments, count);
+                recording.finish(runtime, result);
+
+                return result;
             });
     }
     else if (propName == "copyObjectFromVector")
@@ -195,7 +637,11 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
             [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
                 size_t count) -> jsi::Object
             {
-                return FOCV_Object::copyObjectFromVector(runtime, arguments);
+                FOCV_Recording recording(runtime, "copyObjectFromVector", arguments, count);
+                auto result = FOCV_Object::copyObjectFromVector(runtime, arguments);
+                recording.finish(runtime, result);
+
+                return result;
             });
     }
     else if (propName == "invoke")
@@ -205,7 +651,39 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
             [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
                 size_t count) -> jsi::Object
             {
-                return FOCV_Function::invoke(runtime, arguments);
+                FOCV_Recording recording(runtime, "invoke", arguments, count);
+                auto result = FOCV_Function::invoke(runtime, arguments);
+                recording.finish(runtime, result);
+
+                return result;
+            });
+    }
+    else if (propName == "invokeWithRoi")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "invokeWithRoi"), 1,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Object
+            {
+                FOCV_Recording recording(runtime, "invokeWithRoi", arguments, count);
+                auto result = FOCV_Function::invokeWithRoi(runtime, arguments, count);
+                recording.finish(runtime, result);
+
+                return result;
+            });
+    }
+    else if (propName == "releaseObject")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "releaseObject"), 1,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Value
+            {
+                FOCV_Recording recording(runtime, "releaseObject", arguments, count);
+                FOCV_Storage::release(FOCV_JsiObject::id_from_wrap(runtime, arguments[0]));
+                recording.finish(runtime, jsi::Value(true));
+
+                return true;
             });
     }
     else if (propName == "clearBuffers")
@@ -215,7 +693,88 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
             [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
                 size_t count) -> jsi::Value
             {
+                FOCV_Recording recording(runtime, "clearBuffers", arguments, count);
                 FOCV_Storage::clear();
+                recording.finish(runtime, jsi::Value(true));
+
+                return true;
+            });
+    }
+    else if (propName == "startTracing")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "startTracing"), 1,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Value
+            {
+                size_t capacity = 65536;
+
+                // Negative, NaN and huge capacities from JS are clamped before the conversion
+                if (count > 0 && arguments[0].isNumber()) {
+                    double requested = arguments[0].asNumber();
+                    capacity = requested >= 1 ? static_cast<size_t>(std::min<double>(requested, FOCV_TraceMaxCapacity)) : 1;
+                }
+
+                FOCV_Trace::start(capacity);
+                return true;
+            });
+    }
+    else if (propName == "stopTracing")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "stopTracing"), 0,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Value
+            {
+                FOCV_Trace::stop();
+                return true;
+            });
+    }
+    else if (propName == "exportTrace")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "exportTrace"), 1,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Value
+            {
+                if (count > 0 && arguments[0].isString()) {
+                    std::string path = arguments[0].asString(runtime).utf8(runtime);
+
+                    if (!FOCV_Trace::exportToFile(path)) {
+                        throw std::runtime_error("Unable to write trace to " + path);
+                    }
+
+                    return jsi::String::createFromUtf8(runtime, path);
+                }
+
+                return jsi::String::createFromUtf8(runtime, FOCV_Trace::exportJSON());
+            });
+    }
+    else if (propName == "startRecording")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "startRecording"), 2,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Value
+            {
+                std::string path = arguments[0].asString(runtime).utf8(runtime);
+                bool hashBuffers = count > 1 && arguments[1].isBool() && arguments[1].getBool();
+
+                if (!FOCV_Recorder::start(path, hashBuffers)) {
+                    throw std::runtime_error("Unable to open recording file " + path);
+                }
+
+                return true;
+            });
+    }
+    else if (propName == "stopRecording")
+    {
+        return jsi::Function::createFromHostFunction(
+            runtime, jsi::PropNameID::forAscii(runtime, "stopRecording"), 0,
+            [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
+                size_t count) -> jsi::Value
+            {
+                FOCV_Recorder::stop();
                 return true;
             });
     }
@@ -226,6 +785,8 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
             [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
                 size_t count) -> jsi::Object
             {
+                FOCV_TraceScope trace("conversion", "getMatData");
+                FOCV_Recording recording(runtime, "getMatData", arguments, count);
                 jsi::Object value(runtime);
 
                 std::string id = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
@@ -241,20 +802,24 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
                 value.setProperty(runtime, "cols", jsi::Value(mat.cols));
                 value.setProperty(runtime, "rows", jsi::Value(mat.rows));
                 
+                recording.finish(runtime, value);
                 return value;
             });
     }
     else if (propName == "getMatRoi")
     {
         return jsi::Function::createFromHostFunction(
-            runtime, jsi::PropNameID::forAscii(runtime, "getMatData"), 1,
+            runtime, jsi::PropNameID::forAscii(runtime, "getMatRoi"), 1,
             [=](jsi::Runtime &runtime, const jsi::Value &thisValue, const jsi::Value *arguments,
                 size_t count) -> jsi::Object
             {
-                // arg: mat, roiRect
+                // arg: mat, roiRect, copy?
+                FOCV_TraceScope trace("conversion", "getMatRoi");
+                FOCV_Recording recording(runtime, "getMatRoi", arguments, count);
                 jsi::Object value(runtime);
                 std::string matId = FOCV_JsiObject::id_from_wrap(runtime, arguments[0]);
                 std::string rectId = FOCV_JsiObject::id_from_wrap(runtime, arguments[1]);
+                bool copy = count > 2 && arguments[2].isBool() && arguments[2].getBool();
 
                 auto mat = *FOCV_Storage::get<cv::Mat>(matId);
                 auto roiRect = *FOCV_Storage::get<cv::Rect>(rectId);
@@ -263,17 +828,27 @@ jsi::Value OpenCVPlugin::get(jsi::Runtime &runtime, const jsi::PropNameID &propN
 
                 auto intersection = image_rect & roiRect;
 
-                // Move intersection to the result coordinate space
-                auto inter_roi = intersection - roiRect.tl();
+                cv::Mat crop;
 
-                // Create black image and copy intersection
-                cv::Mat crop = cv::Mat::zeros(roiRect.size(), mat.type());
-                mat(intersection).copyTo(crop(inter_roi));
+                if (intersection == roiRect && !copy) {
+                    // Header sharing the parent's data, no pixels are copied
+                    crop = mat(roiRect);
+                } else {
+                    // Move intersection to the result coordinate space
+                    auto inter_roi = intersection - roiRect.tl();
+
+                    // Create black image and copy intersection
+                    crop = cv::Mat::zeros(roiRect.size(), mat.type());
+                    mat(intersection).copyTo(crop(inter_roi));
+                }
 
                 std::string id = "";
                 id = FOCV_Storage::save(crop);
                 
-                return FOCV_JsiObject::wrap(runtime, "mat", id);
+                auto result = FOCV_JsiObject::wrap(runtime, "mat", id);
+                recording.finish(runtime, result);
+
+                return result;
             });
     }
 
@@ -287,14 +862,33 @@ std::vector<jsi::PropNameID> OpenCVPlugin::getPropertyNames(jsi::Runtime &runtim
     result.push_back(jsi::PropNameID::forAscii(runtime, "frameBufferToMat"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "bufferToMat"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "base64ToMat"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "bytesToMat"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "matToBytes"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "encodeMat"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "imread"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "loadNet"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "forward"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "processTiled"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "imwrite"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "batchDecode"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "saveMat"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "loadMat"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "matToBuffer"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "vectorToBuffer"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "createObject"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "toJSValue"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "copyObjectFromVector"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "invoke"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "invokeWithRoi"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "clearBuffers"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "releaseObject"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "getMatData"));
     result.push_back(jsi::PropNameID::forAscii(runtime, "getMatRoi"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "startTracing"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "stopTracing"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "exportTrace"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "startRecording"));
+    result.push_back(jsi::PropNameID::forAscii(runtime, "stopRecording"));
 
     return result;
 }
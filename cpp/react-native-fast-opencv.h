@@ -3,6 +3,8 @@
 
 #include <jsi/jsilib.h>
 #include <jsi/jsi.h>
+#include <memory>
+#include <unordered_map>
 
 #ifdef __cplusplus
 #undef YES
@@ -18,7 +20,7 @@ using namespace cv;
 #endif
 #endif
 
-#ifdef ANDROID
+#if defined(ANDROID) || defined(FOCV_HOST_BUILD)
 #include <ReactCommon/CallInvoker.h>
 #else
 #include <React-callinvoker/ReactCommon/CallInvoker.h>
@@ -26,9 +28,20 @@ using namespace cv;
 
 using namespace facebook;
 
+namespace mrousavy {
+class Promise;
+}
+
+class FOCV_DecodeWorker;
+
 class OpenCVPlugin : public jsi::HostObject {
 private:
     std::shared_ptr<react::CallInvoker> _callInvoker;
+    // Promises of batchDecode calls in flight, only touched on the JS thread.
+    // They go away with the plugin, so batches finishing later settle nothing.
+    std::shared_ptr<std::unordered_map<mrousavy::Promise*, std::shared_ptr<mrousavy::Promise>>> _pendingDecodes;
+    // Declared last so it is joined before the pending promises are released
+    std::shared_ptr<FOCV_DecodeWorker> _decodeWorker;
     
 public:
     explicit OpenCVPlugin(std::shared_ptr<react::CallInvoker> callInvoker);
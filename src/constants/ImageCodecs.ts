@@ -0,0 +1,29 @@
+export enum ImreadModes {
+  IMREAD_UNCHANGED = -1,
+  IMREAD_GRAYSCALE = 0,
+  IMREAD_COLOR = 1,
+  IMREAD_ANYDEPTH = 2,
+  IMREAD_ANYCOLOR = 4,
+  IMREAD_LOAD_GDAL = 8,
+  IMREAD_REDUCED_GRAYSCALE_2 = 16,
+  IMREAD_REDUCED_COLOR_2 = 17,
+  IMREAD_REDUCED_GRAYSCALE_4 = 32,
+  IMREAD_REDUCED_COLOR_4 = 33,
+  IMREAD_REDUCED_GRAYSCALE_8 = 64,
+  IMREAD_REDUCED_COLOR_8 = 65,
+  IMREAD_IGNORE_ORIENTATION = 128,
+}
+
+export enum ImwriteFlags {
+  IMWRITE_JPEG_QUALITY = 1,
+  IMWRITE_JPEG_PROGRESSIVE = 2,
+  IMWRITE_JPEG_OPTIMIZE = 3,
+  IMWRITE_JPEG_RST_INTERVAL = 4,
+  IMWRITE_JPEG_LUMA_QUALITY = 5,
+  IMWRITE_JPEG_CHROMA_QUALITY = 6,
+  IMWRITE_PNG_COMPRESSION = 16,
+  IMWRITE_PNG_STRATEGY = 17,
+  IMWRITE_PNG_BILEVEL = 18,
+  IMWRITE_PXM_BINARY = 32,
+  IMWRITE_WEBP_QUALITY = 64,
+}
@@ -171,6 +171,14 @@ export enum ConnectedComponentsTypes {
   CC_STAT_AREA = 4,
 }
 
+export enum ContourSortKeys {
+  AREA = 0,
+  PERIMETER = 1,
+  ASPECT = 2,
+  SOLIDITY = 3,
+  VERTICES = 4,
+}
+
 export enum ContourApproximationModes {
   CHAIN_APPROX_NONE = 1,
   CHAIN_APPROX_SIMPLE = 2,
@@ -916,6 +916,8 @@ export type Core = {
   invoke(name: 'convertTo', src: Mat, dst: Mat, rtype: DataTypes): void;
   invoke(name: 'resize', src: Mat, dst: Mat, size: Size, fx?: number, fy?: number, interpolation?: number): void;
   invoke(name: 'warpAffine', src: Mat, dst: Mat, M: Mat, size: Size, flags?: number, borderMode?: number): void;
+  invoke(name: 'warpPerspective', src: Mat, dst: Mat, M: Mat, size: Size, flags?: number, borderMode?: number): void;
+  invoke(name: 'getPerspectiveTransform', src: Mat, dst: Mat): Mat;
   invoke(name: 'getRotationMatrix2D', center: Point, angle: number, scale: number): Mat;
   invoke(name: 'rotateBound', src: Mat, angle: number, scale: number): Mat;
   invoke(name: 'cropAndAlign', src: Mat, width: number, height: number, center: Point, left: number, top: number, scale: number, angle: number): Mat;
@@ -0,0 +1,56 @@
+import type { FeatureIndex, Mat } from '../objects/Objects';
+
+export type Features2d = {
+  /**
+   * Extracts ORB features of a reference image and adds them to a feature index
+   * @param name Function name.
+   * @param index Index created with `createObject(ObjectType.FeatureIndex, ...)`
+   * @param image Reference image
+   * @returns id of the reference, which is its position in the index, and the number of detected keypoints
+   */
+  invoke(
+    name: 'addFeatureReference',
+    index: FeatureIndex,
+    image: Mat
+  ): { id: number; keypoints: number };
+
+  /**
+   * Finds which reference of a feature index is visible in a frame. The best candidates are verified with a RANSAC homography
+   * @param name Function name.
+   * @param index Feature index
+   * @param frame Query image
+   * @returns id of the recognized reference, or -1, with the number of ratio-test matches and homography inliers. When a reference is recognized, also the 3x3 homography from the reference to the frame and the reference corners in the frame
+   */
+  invoke(
+    name: 'matchFeatureIndex',
+    index: FeatureIndex,
+    frame: Mat
+  ): {
+    id: number;
+    matches: number;
+    inliers: number;
+    homography?: Float32Array;
+    corners?: Float32Array;
+  };
+
+  /**
+   * Writes the descriptors of a feature index to a file
+   * @param name Function name.
+   * @param index Feature index
+   * @param path Local file path or file:// URI
+   */
+  invoke(name: 'saveFeatureIndex', index: FeatureIndex, path: string): void;
+
+  /**
+   * Replaces the references of a feature index with the ones saved in a file
+   * @param name Function name.
+   * @param index Feature index
+   * @param path Local file path or file:// URI
+   * @returns number of loaded references
+   */
+  invoke(
+    name: 'loadFeatureIndex',
+    index: FeatureIndex,
+    path: string
+  ): { count: number };
+};
@@ -0,0 +1,71 @@
+import type { BorderTypes } from '../../constants/Core';
+import type { Mat, RemapTransform, Size } from '../../objects/Objects';
+
+export type GeometricTransform = {
+  /**
+   * Bakes an affine or perspective warp into the remap tables of a transform. The tables are only rebuilt when the matrix or the size changes by more than the tolerance of the transform
+   * @param name Function name
+   * @param transform Transform created with `createObject(ObjectType.RemapTransform, tolerance)`
+   * @param M 2x3 affine or 3x3 perspective matrix, like for warpAffine and warpPerspective
+   * @param size Size of the output image
+   * @returns rebuilt is true when the tables were recomputed
+   */
+  invoke(
+    name: 'setRemapWarp',
+    transform: RemapTransform,
+    M: Mat,
+    size: Size
+  ): { rebuilt: boolean };
+
+  /**
+   * Bakes a lens undistortion into the remap tables of a transform
+   * @param name Function name
+   * @param transform Transform created with `createObject(ObjectType.RemapTransform, tolerance)`
+   * @param cameraMatrix Input camera matrix
+   * @param distCoeffs Input vector of distortion coefficients (k1, k2, p1, p2[, k3[, k4, k5, k6]])
+   * @param size Size of the output image
+   * @param newCameraMatrix Camera matrix of the output image, e.g. with a crop applied. The input camera matrix by default
+   * @returns rebuilt is true when the tables were recomputed
+   */
+  invoke(
+    name: 'setRemapUndistort',
+    transform: RemapTransform,
+    cameraMatrix: Mat,
+    distCoeffs: Mat,
+    size: Size,
+    newCameraMatrix?: Mat
+  ): { rebuilt: boolean };
+
+  /**
+   * Bakes a custom mesh warp into the remap tables of a transform
+   * @param name Function name
+   * @param transform Transform created with `createObject(ObjectType.RemapTransform, tolerance)`
+   * @param mesh CV_32FC2 grid of source coordinates, spread evenly over the output with its corners on the output corners
+   * @param size Size of the output image
+   * @returns rebuilt is true when the tables were recomputed
+   */
+  invoke(
+    name: 'setRemapMesh',
+    transform: RemapTransform,
+    mesh: Mat,
+    size: Size
+  ): { rebuilt: boolean };
+
+  /**
+   * Applies the remap tables of a transform to an image
+   * @param name Function name
+   * @param transform Transform with tables set by setRemapWarp, setRemapUndistort or setRemapMesh
+   * @param src Source image
+   * @param dst Destination image, of the size given to the transform
+   * @param interpolation Interpolation method, INTER_LINEAR by default
+   * @param borderMode Pixel extrapolation method, BORDER_CONSTANT by default, @see BorderTypes
+   */
+  invoke(
+    name: 'applyRemap',
+    transform: RemapTransform,
+    src: Mat,
+    dst: Mat,
+    interpolation?: number,
+    borderMode?: BorderTypes
+  ): void;
+};
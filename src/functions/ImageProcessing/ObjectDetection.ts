@@ -1,5 +1,5 @@
 import type { TemplateMatchModes } from '../../constants/ImageProcessing';
-import type { Mat } from '../../objects/Objects';
+import type { Mat, TemplateSet } from '../../objects/Objects';
 
 export type ObjectDetection = {
   /**
@@ -19,4 +19,56 @@ export type ObjectDetection = {
     method: TemplateMatchModes,
     mask: Mat
   ): void;
+
+  /**
+   * Finds all templates of a template set in an image, at every scale of the set
+   * @param name Function name
+   * @param templates Template set created with `createObject(ObjectType.TemplateSet, ...)`
+   * @param image Image where the search is running
+   * @param threshold Minimum score of a match, between 0 and 1
+   * @param maxMatches Maximum number of returned matches
+   * @param overlap Maximum overlap (IoU) between two returned matches
+   * @returns matches holds 7 values per match: score, scale, template index, x, y, width, height
+   */
+  invoke(
+    name: 'matchTemplates',
+    templates: TemplateSet,
+    image: Mat,
+    threshold: number,
+    maxMatches: number,
+    overlap?: number
+  ): { count: number; matches: Float32Array };
+
+  /**
+   * Finds the largest convex quadrilateral in an image, e.g. a document page
+   * @param name Function name
+   * @param src Source image
+   * @param workingSize Long side of the downscaled copy the edges are detected on, 400 by default
+   * @param minAreaRatio Minimum quad area relative to the image area, 0.2 by default
+   * @returns corners in full resolution, ordered top-left, top-right, bottom-right, bottom-left, as a Mat and as 8 packed coordinates
+   */
+  invoke(
+    name: 'detectDocumentQuad',
+    src: Mat,
+    workingSize?: number,
+    minAreaRatio?: number
+  ): { found: false } | { found: true; corners: Mat; points: Float32Array };
+
+  /**
+   * Warps a quadrilateral of the image to a rectangle. The transform is reused while the corners and the size stay the same
+   * @param name Function name
+   * @param src Source image
+   * @param dst Rectified image
+   * @param corners 4 corners ordered top-left, top-right, bottom-right, bottom-left, e.g. from detectDocumentQuad
+   * @param width Width of the rectified image. By default, the longer of the top and bottom edges
+   * @param height Height of the rectified image. By default, the longer of the left and right edges
+   */
+  invoke(
+    name: 'rectifyDocument',
+    src: Mat,
+    dst: Mat,
+    corners: Mat,
+    width?: number,
+    height?: number
+  ): void;
 };
@@ -1,5 +1,6 @@
 import type {
   ContourApproximationModes,
+  ContourSortKeys,
   DistanceTypes,
   RetrievalModes,
   ShapeMatchModes,
@@ -116,6 +117,38 @@ export type Shape = {
     method: ContourApproximationModes
   ): void;
 
+  /**
+   * Filters contours by their shape and returns the best ones, in a single call
+   * @param contours Contours, e.g. from findContours
+   * @param minArea Minimum contour area
+   * @param maxArea Maximum contour area, 0 for no limit
+   * @param minVertices Minimum vertex count of the approximated polygon
+   * @param maxVertices Maximum vertex count of the approximated polygon, 0 for no limit
+   * @param minAspect Minimum ratio of the short to the long side of the minimum area rectangle, between 0 and 1
+   * @param maxAspect Maximum aspect ratio, 0 for no limit
+   * @param minSolidity Minimum ratio of the contour area to its convex hull area, between 0 and 1
+   * @param topK Maximum number of returned contours, 0 for all
+   * @param sortBy Metric the contours are ranked by, largest first, @see ContourSortKeys
+   * @param epsilon Approximation accuracy relative to the contour perimeter, 0.02 by default
+   * @param approxCurves Receives the approximated polygons of the returned contours
+   * @returns metrics holds 10 values per contour: index, area, perimeter, aspect, solidity, vertices, x, y, width, height
+   */
+  invoke(
+    name: 'filterContours',
+    contours: MatVector,
+    minArea: number,
+    maxArea?: number,
+    minVertices?: number,
+    maxVertices?: number,
+    minAspect?: number,
+    maxAspect?: number,
+    minSolidity?: number,
+    topK?: number,
+    sortBy?: ContourSortKeys,
+    epsilon?: number,
+    approxCurves?: MatVector
+  ): { count: number; metrics: Float32Array };
+
   /**
    * Fits a line to a 2D or 3D point set.
    * @param points Input vector of 2D or 3D points, stored in a Mat.
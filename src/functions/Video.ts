@@ -0,0 +1,173 @@
+import type {
+  BackgroundModel,
+  DirtyTracker,
+  FrameRing,
+  FrameSignature,
+  Mat,
+  ObjectTracker,
+  PointTracker,
+  RectVector,
+  Size,
+} from '../objects/Objects';
+
+export type Video = {
+  /**
+   * Calculates an optical flow for a sparse feature set using the iterative Lucas-Kanade method with pyramids.
+   * @param name Function name.
+   * @param prevImg first 8-bit input image or pyramid
+   * @param nextImg second input image or pyramid of the same size and the same type as prevImg
+   * @param prevPts vector of 2D points for which the flow needs to be found; point coordinates must be single-precision floating-point numbers
+   * @param nextPts output vector of 2D points containing the calculated new positions of input features in the second image
+   * @param status output status vector; each element of the vector is set to 1 if the flow for the corresponding features has been found, otherwise, it is set to 0
+   * @param err output vector of errors; each element of the vector is set to an error for the corresponding feature
+   * @param winSize size of the search window at each pyramid level
+   * @param maxLevel 0-based maximal pyramid level number
+   */
+  invoke(
+    name: 'calcOpticalFlowPyrLK',
+    prevImg: Mat,
+    nextImg: Mat,
+    prevPts: Mat,
+    nextPts: Mat,
+    status: Mat,
+    err: Mat,
+    winSize?: Size,
+    maxLevel?: number
+  ): void;
+
+  /**
+   * Tracks the points of a point tracker into the next frame with pyramidal Lucas-Kanade. Lost points are dropped and new corners are detected when fewer than minPoints are left.
+   * @param name Function name.
+   * @param tracker Point tracker created with createObject
+   * @param frame Next frame, grayscale or color
+   * @returns number of points, their positions as x,y pairs and their stable ids
+   */
+  invoke(
+    name: 'trackPoints',
+    tracker: PointTracker,
+    frame: Mat
+  ): { count: number; points: Float32Array; ids: Int32Array };
+
+  /**
+   * Drops all tracked points and the previous frame of a point tracker.
+   * @param name Function name.
+   * @param tracker Point tracker created with createObject
+   */
+  invoke(name: 'resetPointTracker', tracker: PointTracker): void;
+
+  /**
+   * Updates a background model with the next frame and returns the regions that changed. MOG2 and KNN use the OpenCV background subtractors, average keeps a running average of the grayscale frames.
+   * @param name Function name.
+   * @param model Background model created with createObject
+   * @param frame Next frame
+   * @param mask Output foreground mask (255 for foreground), with the size of the downscaled frame when the model uses a scale below 1
+   * @returns number of changed regions and their bounding rects as x,y,width,height in frame coordinates
+   */
+  invoke(
+    name: 'applyBackgroundModel',
+    model: BackgroundModel,
+    frame: Mat,
+    mask: Mat
+  ): { count: number; rects: Int32Array };
+
+  /**
+   * Updates an object tracker with the detections of the current frame. Without detections, the tracks are only predicted, so detection can run every Nth frame.
+   * @param name Function name.
+   * @param tracker Object tracker created with createObject
+   * @param detections Detected boxes of the current frame
+   * @param scores Detection scores, in the order of the boxes
+   * @returns number of confirmed tracks, their stable ids, and 6 values per track: x, y, width, height, score and frames since the last matching detection
+   */
+  invoke(
+    name: 'updateObjectTracker',
+    tracker: ObjectTracker,
+    detections?: RectVector,
+    scores?: Float32Array | number[]
+  ): { count: number; ids: Int32Array; tracks: Float32Array };
+
+  /**
+   * Drops all tracks of an object tracker.
+   * @param name Function name.
+   * @param tracker Object tracker created with createObject
+   */
+  invoke(name: 'resetObjectTracker', tracker: ObjectTracker): void;
+
+  /**
+   * Copies a frame into the oldest slot of a frame ring.
+   * @param name Function name.
+   * @param ring Frame ring created with createObject
+   * @param frame Mat of the size and type of the ring, or raw pixel data of one frame
+   * @returns number of frames held by the ring
+   */
+  invoke(
+    name: 'pushFrameRing',
+    ring: FrameRing,
+    frame: Mat | Uint8Array | Float32Array
+  ): { count: number };
+
+  /**
+   * Returns a frame of a frame ring without copying it. The Mat is overwritten once the ring wraps around.
+   * @param name Function name.
+   * @param ring Frame ring
+   * @param offset 0 for the newest frame, 1 for the one before, and so on
+   */
+  invoke(name: 'getFrameRingSlot', ring: FrameRing, offset?: number): Mat;
+
+  /**
+   * Reduces the newest frames of a frame ring per pixel, in parallel.
+   * @param name Function name.
+   * @param ring Frame ring
+   * @param dst Output Mat of the size and type of the ring
+   * @param operation Reduction across the frames
+   * @param frames Number of newest frames to reduce, all by default
+   */
+  invoke(
+    name: 'reduceFrameRing',
+    ring: FrameRing,
+    dst: Mat,
+    operation: 'mean' | 'median' | 'max' | 'min',
+    frames?: number
+  ): void;
+
+  /**
+   * Compares the signature of a frame with the one of the last changed frame. The frame is sampled on a sparse grid, so the cost does not depend on its size.
+   * @param name Function name.
+   * @param signature Frame signature created with createObject
+   * @param frame Current frame
+   * @returns change score between 0 and 1, and whether it reached the threshold of the signature
+   */
+  invoke(
+    name: 'compareFrameSignature',
+    signature: FrameSignature,
+    frame: Mat
+  ): { score: number; changed: boolean };
+
+  /**
+   * Forgets the last changed frame, so the next frame is reported as changed.
+   * @param name Function name.
+   * @param signature Frame signature created with createObject
+   */
+  invoke(name: 'resetFrameSignature', signature: FrameSignature): void;
+
+  /**
+   * Compares a frame with the reference of a dirty tracker on a tile grid and returns the changed regions, to run expensive functions with invokeWithRoi on them only. The dirty tiles are copied into the reference.
+   * @param name Function name.
+   * @param tracker Dirty tracker created with createObject
+   * @param frame Current frame. The first frame, or one of another size or type, is dirty as a whole.
+   * @param regions Receives non-overlapping rects covering the dirty tiles
+   * @returns number of dirty tiles
+   */
+  invoke(
+    name: 'detectDirtyTiles',
+    tracker: DirtyTracker,
+    frame: Mat,
+    regions: RectVector
+  ): { count: number };
+
+  /**
+   * Drops the reference of a dirty tracker, so the next frame is dirty as a whole.
+   * @param name Function name.
+   * @param tracker Dirty tracker created with createObject
+   */
+  invoke(name: 'resetDirtyTracker', tracker: DirtyTracker): void;
+};
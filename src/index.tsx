@@ -3,11 +3,14 @@ import type { ColorMap } from './functions/ImageProcessing/ColorMap';
 import type { Drawing } from './functions/ImageProcessing/Drawing';
 import type { Feature } from './functions/ImageProcessing/Feature';
 import type { ImageFiltering } from './functions/ImageProcessing/ImageFiltering';
+import type { GeometricTransform } from './functions/ImageProcessing/GeometricTransform';
 import type { Misc } from './functions/ImageProcessing/Misc';
 import type { ObjectDetection } from './functions/ImageProcessing/ObjectDetection';
 import type { Shape } from './functions/ImageProcessing/Shape';
 import type { ColorConversion } from './functions/ColorConversion';
 import type { Core } from './functions/Core';
+import type { Features2d } from './functions/Features2d';
+import type { Video } from './functions/Video';
 import type { UtilsFunctions } from './utils/UtilsFunctions';
 import type { Objects } from './objects/Objects';
 
@@ -53,11 +56,14 @@ export type OpenCVModel = ColorMap &
   Drawing &
   Feature &
   ImageFiltering &
+  GeometricTransform &
   Misc &
   ObjectDetection &
   Shape &
   ColorConversion &
   Core &
+  Features2d &
+  Video &
   Objects &
   UtilsFunctions;
 
@@ -67,3 +73,4 @@ export * from './constants/ColorConversionsCodes';
 export * from './constants/DataTypes';
 export * from './constants/ImageProcessing';
 export * from './constants/Core';
+export * from './constants/ImageCodecs';
@@ -9,4 +9,14 @@ export enum ObjectType {
   Vec3b = 'vec3b',
   Scalar = 'scalar',
   RotatedRect = 'rotated_rect',
+  PointTracker = 'point_tracker',
+  BackgroundModel = 'background_model',
+  TemplateSet = 'template_set',
+  RemapTransform = 'remap_transform',
+  FeatureIndex = 'feature_index',
+  DnnNet = 'dnn_net',
+  ObjectTracker = 'object_tracker',
+  FrameRing = 'frame_ring',
+  FrameSignature = 'frame_signature',
+  DirtyTracker = 'dirty_tracker',
 }
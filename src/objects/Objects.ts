@@ -1,4 +1,12 @@
+import type { ColorConversionCodes } from '../constants/ColorConversionsCodes';
 import type { DataTypes } from '../constants/DataTypes';
+import type {
+  AdaptiveThresholdTypes,
+  MorphShapes,
+  MorphTypes,
+  TemplateMatchModes,
+  ThresholdTypes,
+} from '../constants/ImageProcessing';
 import type { ObjectType } from './ObjectType';
 
 export type Mat = { id: string; type: ObjectType.Mat };
@@ -11,9 +19,81 @@ export type Size = { id: string; type: ObjectType.Size };
 export type Vec3b = { id: string; type: ObjectType.Vec3b };
 export type Scalar = { id: string; type: ObjectType.Scalar };
 export type RotatedRect = { id: string; type: ObjectType.RotatedRect };
+export type PointTracker = { id: string; type: ObjectType.PointTracker };
+export type BackgroundModel = {
+  id: string;
+  type: ObjectType.BackgroundModel;
+};
+export type TemplateSet = {
+  id: string;
+  type: ObjectType.TemplateSet;
+};
+export type RemapTransform = {
+  id: string;
+  type: ObjectType.RemapTransform;
+};
+export type FeatureIndex = {
+  id: string;
+  type: ObjectType.FeatureIndex;
+};
+export type DnnNet = { id: string; type: ObjectType.DnnNet };
+export type ObjectTracker = {
+  id: string;
+  type: ObjectType.ObjectTracker;
+};
+export type FrameRing = {
+  id: string;
+  type: ObjectType.FrameRing;
+};
+export type FrameSignature = {
+  id: string;
+  type: ObjectType.FrameSignature;
+};
+export type DirtyTracker = {
+  id: string;
+  type: ObjectType.DirtyTracker;
+};
 
 export type Vector = MatVector | PointVector | RectVector;
 export type Array = Mat | Vec3b;
+export type MatData =
+  | Int8Array
+  | Uint8Array
+  | Uint8ClampedArray
+  | Int16Array
+  | Uint16Array
+  | Int32Array
+  | Float32Array
+  | Float64Array;
+
+export type EncodeOptions = {
+  format?: 'jpg' | 'png' | 'webp';
+  quality?: number;
+  compression?: number;
+  scale?: number;
+};
+
+export type TiledOperation =
+  | { name: 'blur'; ksize: number }
+  | { name: 'GaussianBlur'; ksize: number; sigma?: number }
+  | { name: 'medianBlur'; ksize: number }
+  | {
+      name: 'morphologyEx';
+      op: MorphTypes;
+      ksize: number;
+      shape?: MorphShapes;
+      iterations?: number;
+    }
+  | { name: 'threshold'; thresh: number; maxval: number; type: ThresholdTypes }
+  | {
+      name: 'adaptiveThreshold';
+      maxValue: number;
+      method: AdaptiveThresholdTypes;
+      type: ThresholdTypes;
+      blockSize: number;
+      C: number;
+    }
+  | { name: 'cvtColor'; code: ColorConversionCodes };
 
 export type Objects = {
   // Creation
@@ -22,7 +102,13 @@ export type Objects = {
     rows: number,
     cols: number,
     dataType: DataTypes,
-    data?: number[]
+    data?: number[] | MatData
+  ): Mat;
+  createObject(
+    type: ObjectType.Mat,
+    sizes: number[],
+    dataType: DataTypes,
+    data?: MatData
   ): Mat;
   createObject(type: ObjectType.MatVector): MatVector;
   createObject(type: ObjectType.Point, x: number, y: number): Point;
@@ -50,13 +136,83 @@ export type Objects = {
     c: number,
     d: number
   ): Scalar;
+  createObject(
+    type: ObjectType.PointTracker,
+    maxPoints?: number,
+    minPoints?: number,
+    qualityLevel?: number,
+    minDistance?: number
+  ): PointTracker;
+  createObject(
+    type: ObjectType.BackgroundModel,
+    method?: 'mog2' | 'knn' | 'average',
+    scale?: number,
+    learningRate?: number,
+    threshold?: number,
+    minArea?: number
+  ): BackgroundModel;
+  createObject(
+    type: ObjectType.TemplateSet,
+    templates: MatVector,
+    minScale?: number,
+    maxScale?: number,
+    steps?: number,
+    method?: TemplateMatchModes
+  ): TemplateSet;
+  createObject(
+    type: ObjectType.RemapTransform,
+    tolerance?: number
+  ): RemapTransform;
+  createObject(
+    type: ObjectType.FeatureIndex,
+    features?: number,
+    ratio?: number,
+    minInliers?: number
+  ): FeatureIndex;
+  createObject(
+    type: ObjectType.ObjectTracker,
+    maxAge?: number,
+    minHits?: number,
+    iouThreshold?: number
+  ): ObjectTracker;
+  createObject(
+    type: ObjectType.FrameRing,
+    capacity: number,
+    rows: number,
+    cols: number,
+    dataType: DataTypes
+  ): FrameRing;
+  createObject(
+    type: ObjectType.FrameSignature,
+    method?: 'average' | 'difference' | 'thumbnail',
+    size?: number,
+    threshold?: number
+  ): FrameSignature;
+  createObject(
+    type: ObjectType.DirtyTracker,
+    tileWidth?: number,
+    tileHeight?: number,
+    threshold?: number
+  ): DirtyTracker;
 
-  toJSValue(mat: Mat): {
+  toJSValue(
+    mat: Mat,
+    options?: EncodeOptions & { output?: 'base64' }
+  ): {
     size: number;
     cols: number;
     rows: number;
     base64: string;
   };
+  toJSValue(
+    mat: Mat,
+    options: EncodeOptions & { output: 'buffer' }
+  ): {
+    size: number;
+    cols: number;
+    rows: number;
+    buffer: ArrayBuffer;
+  };
   toJSValue(matVector: MatVector): {
     array: { size: number; cols: number; rows: number }[];
   };
@@ -104,5 +260,18 @@ export type Objects = {
     rows: number;
     data: Uint8Array;
   };
-  getMatRoi(mat: Mat, rectRoi: Rect): Mat;
+  releaseObject(
+    object:
+      | PointTracker
+      | BackgroundModel
+      | TemplateSet
+      | RemapTransform
+      | FeatureIndex
+      | DnnNet
+      | ObjectTracker
+      | FrameRing
+      | FrameSignature
+      | DirtyTracker
+  ): void;
+  getMatRoi(mat: Mat, rectRoi: Rect, copy?: boolean): Mat;
 };
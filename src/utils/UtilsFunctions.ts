@@ -1,4 +1,14 @@
-import type { Mat } from '../objects/Objects';
+import type { ImreadModes } from '../constants/ImageCodecs';
+import type {
+  DnnNet,
+  EncodeOptions,
+  Mat,
+  MatVector,
+  PointVector,
+  Rect,
+  RectVector,
+  TiledOperation,
+} from '../objects/Objects';
 
 export type UtilsFunctions = {
   clearBuffers(): void;
@@ -6,6 +16,48 @@ export type UtilsFunctions = {
   bufferToMat(rows: number, cols: number, input: Uint8Array): Mat;
   bufferF32ToMat(rows: number, cols: number, input: Float32Array): Mat;
   base64ToMat(data: string): Mat;
+  bytesToMat(data: ArrayBuffer | Uint8Array): Mat;
+  batchDecode(
+    sources: (string | ArrayBuffer | Uint8Array)[],
+    options?: {
+      flags?: ImreadModes;
+      width?: number;
+      height?: number;
+      strings?: 'base64' | 'path';
+    }
+  ): Promise<{ images: MatVector; failed: { index: number; message: string }[] }>;
+  imread(path: string, flags?: ImreadModes): Mat;
+  imwrite(path: string, mat: Mat, params?: number[]): void;
+  saveMat(path: string, object: Mat | MatVector | PointVector): void;
+  loadMat(path: string, copy?: boolean): Mat | MatVector | PointVector;
+  loadNet(path: string, options?: { config?: string; threads?: number }): DnnNet;
+  forward(
+    net: DnnNet,
+    input: Mat,
+    options?: {
+      width?: number;
+      height?: number;
+      scale?: number;
+      mean?: number[];
+      swapRB?: boolean;
+      crop?: boolean;
+      outputs?: Float32Array[];
+    }
+  ): { outputs: MatVector; names: string[] };
+  processTiled(
+    source: Mat | string,
+    operations: TiledOperation[],
+    options?: { tileSize?: number; cacheSize?: number; flags?: ImreadModes }
+  ): Mat;
+  matToBytes(mat: Mat, format?: 'jpg' | 'png' | 'webp'): ArrayBuffer;
+  encodeMat(
+    mat: Mat,
+    options?: EncodeOptions & { output?: 'base64' }
+  ): string;
+  encodeMat(
+    mat: Mat,
+    options: EncodeOptions & { output: 'buffer' }
+  ): ArrayBuffer;
   matToBuffer(
     mat: Mat,
     type: 'uint8'
@@ -14,4 +66,18 @@ export type UtilsFunctions = {
     mat: Mat,
     type: 'float32'
   ): { cols: number; rows: number; channels: number; buffer: Float32Array };
+  vectorToBuffer(
+    vector: PointVector | RectVector
+  ): { count: number; buffer: Int32Array };
+  vectorToBuffer(vector: MatVector): {
+    count: number;
+    buffer: Int32Array | Float32Array;
+    offsets: Int32Array;
+  };
+  invokeWithRoi(roi: Rect | Mat, name: string, ...args: unknown[]): any;
+  startTracing(capacity?: number): void;
+  stopTracing(): void;
+  exportTrace(path?: string): string;
+  startRecording(path: string, hashBuffers?: boolean): void;
+  stopRecording(): void;
 };